@@ -0,0 +1,71 @@
+/**
+ * @file CellListBenchmark.cpp
+ * @brief Times the rebuild of the linked-cell lists and the force traversal that follows it.
+ *
+ * A random gas is moved a little every step (so particles change cells), then the cell lists are rebuilt and the
+ * truncated Lennard-Jones forces computed. The rebuild is reported on its own since it is the part the cell list
+ * layout decides; the traversal shows what the layout costs or saves when the lists are read.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/Parallel.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  std::printf("particles: %d, threads: %d, hardware threads (OpenMP): %d\n", n, threads, parallel::maxThreads());
+  std::printf("%8s %14s %14s   (ms/step)\n", "density", "rebuild", "forces");
+
+  for (const double density : {0.05, 0.8}) {
+    const double side = std::cbrt(n / density);
+    LinkedCellContainer container(r_cutoff, {side, side, side});
+    container.setNumThreads(threads);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.1, side - 0.1);
+    for (int i = 0; i < n; ++i) {
+      container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+    }
+    container.rebuild();
+
+    // every particle moves by up to 0.05 per step and bounces back and forth, so nothing leaves the box
+    int step = 0;
+    auto jiggle = [&step](Particle &p) {
+      auto x = p.getX();
+      x[0] += (step % 2 == 0 ? 0.05 : -0.05);
+      p.setX(x);
+    };
+    const double rebuild = secondsPerStep(
+        [&] {
+          ++step;
+          container.rebuild(jiggle);
+        },
+        repetitions);
+    const double forces = secondsPerStep([&] { force.calculateF(container); }, repetitions);
+    std::printf("%8.2f %14.3f %14.3f\n", density, 1e3 * rebuild, 1e3 * forces);
+  }
+  return 0;
+}
@@ -0,0 +1,133 @@
+/**
+ * @file HugePageBenchmark.cpp
+ * @brief TLB misses and time of the force traversal with and without huge-page backed arrays.
+ *
+ * A random gas is stored in a linked-cell container that is created after the huge page mode was set, so its arrays
+ * and (after distributeStorage) its particles are backed accordingly. For every mode the truncated Lennard-Jones
+ * forces are computed a few times; the dTLB load misses are counted with perf_event_open where the kernel allows
+ * it (perf_event_paranoid), otherwise only the time is reported.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/HugePages.h"
+#include "utils/Parallel.h"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+/// Counter of the data TLB load misses of this process (all threads), -1 if unavailable.
+class TlbMissCounter {
+ public:
+  TlbMissCounter() {
+#ifdef __linux__
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                  (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = 1;
+    attr.inherit = 1;  // threads created later count as well
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+  }
+  ~TlbMissCounter() {
+#ifdef __linux__
+    if (fd >= 0) close(fd);
+#endif
+  }
+  TlbMissCounter(const TlbMissCounter &) = delete;
+  TlbMissCounter &operator=(const TlbMissCounter &) = delete;
+
+  [[nodiscard]] bool available() const { return fd >= 0; }
+  void start() {
+#ifdef __linux__
+    if (fd < 0) return;
+    ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+  }
+  /// Misses since start().
+  long long stop() {
+#ifdef __linux__
+    if (fd < 0) return -1;
+    ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    long long count = 0;
+    if (read(fd, &count, sizeof(count)) != sizeof(count)) return -1;
+    return count;
+#else
+    return -1;
+#endif
+  }
+
+ private:
+  int fd = -1;
+};
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 200000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : parallel::maxThreads();
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  const double side = std::cbrt(n / 0.5);
+  TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  TlbMissCounter counter;
+  std::printf("particles: %d, threads: %d, TLB counter: %s\n", n, threads,
+              counter.available() ? "dTLB load misses" : "unavailable (perf_event_paranoid?)");
+  std::printf("%12s %12s %16s %14s %14s\n", "mode", "ms/step", "dTLB miss/step", "explicit MiB", "THP MiB");
+
+  long long baseline = -1;
+  for (const auto mode : {HugePageMode::None, HugePageMode::Transparent, HugePageMode::Explicit}) {
+    memory::setHugePageMode(mode);
+    {
+      LinkedCellContainer container(r_cutoff, {side, side, side});
+      std::mt19937 gen(42);
+      std::uniform_real_distribution<double> dist(0.0, side);
+      for (int i = 0; i < n; ++i) {
+        container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+      }
+      container.setNumThreads(threads);
+      container.distributeStorage();
+      force.calculateF(container);  // warm up
+
+      counter.start();
+      const auto start = std::chrono::steady_clock::now();
+      for (int i = 0; i < repetitions; ++i) {
+        force.calculateF(container);
+      }
+      const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      const auto misses = counter.stop();
+
+      const auto stats = memory::hugePageStats();
+      const char *name = mode == HugePageMode::None ? "None" : mode == HugePageMode::Transparent ? "Transparent"
+                                                                                                 : "Explicit";
+      std::printf("%12s %12.3f", name, 1e3 * elapsed.count() / repetitions);
+      if (misses >= 0) {
+        if (baseline < 0) baseline = misses;
+        std::printf(" %16lld (%5.1f%%)", misses / repetitions, baseline > 0 ? 100.0 * misses / baseline : 100.0);
+      } else {
+        std::printf(" %16s", "n/a");
+      }
+      std::printf(" %14.1f %14.1f\n", stats.explicitBytes / 1048576.0, stats.transparentBytes / 1048576.0);
+    }
+  }
+  memory::setHugePageMode(HugePageMode::None);
+  return 0;
+}
@@ -0,0 +1,65 @@
+/**
+ * @file LennardJonesBenchmark.cpp
+ * @brief Compares the pair throughput of LennardJones::calc with the vectorized kernels.
+ *
+ * A random gas at liquid density (rho = 0.8) is stored in a linked-cell container; every variant computes the
+ * forces of the same cell pairs, so pairs per second are directly comparable.
+ */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/LennardJones.h"
+#include "ForceCalculation/VectorizedLennardJones.h"
+
+namespace {
+constexpr double epsilon = 5.0;
+constexpr double sigma = 1.0;
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 5;
+  const double side = std::cbrt(n / 0.8);
+  const std::array<double, 3> domain{side, side, side};
+
+  LinkedCellContainer container(r_cutoff, domain);
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, side);
+  for (int i = 0; i < n; ++i) {
+    container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+  }
+
+  std::size_t pairs = 0;
+  container.forEachPair([&pairs](Particle &, Particle &) { ++pairs; });
+  std::printf("particles: %d, cell pairs visited per step: %zu\n", n, pairs);
+
+  const double calc_time = secondsPerStep(
+      [&container] { container.forEachPair([](Particle &p1, Particle &p2) { LennardJones::calc(p1, p2, epsilon, sigma); }); },
+      repetitions);
+  std::printf("%-20s %10.3f ms/step %14.3e pairs/s\n", "LennardJones::calc", 1e3 * calc_time, pairs / calc_time);
+
+  for (const auto isa : {LennardJonesKernel::Isa::Scalar, LennardJonesKernel::Isa::SSE4, LennardJonesKernel::Isa::AVX2,
+                         LennardJonesKernel::Isa::AVX512}) {
+    if (!LennardJonesKernel::isSupported(isa)) continue;
+    VectorizedLennardJones vectorized(epsilon, sigma, r_cutoff, isa);
+    const double time = secondsPerStep([&] { vectorized.calculateF(container); }, repetitions);
+    std::printf("%-20s %10.3f ms/step %14.3e pairs/s (x%.2f)\n", LennardJonesKernel::isaName(isa), 1e3 * time,
+                pairs / time, calc_time / time);
+  }
+  return 0;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file LoadBalanceBenchmark.cpp
+ * @brief Compares the dynamic and the work-stealing cell schedule on a falling-drop scene.
+ *
+ * A dense spherical drop (liquid density) sits in a large box filled with a thin vapour, so a few cells hold most of
+ * the pairs. The colored force traversal is timed with both schedules for 1, 2, 4, ... threads; for the
+ * work-stealing schedule the per-thread busy time and the imbalance max / mean are reported as well.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/Parallel.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int drop = argc > 1 ? std::atoi(argv[1]) : 30000;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : parallel::maxThreads();
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  // the drop at density 0.8 fills a sphere of radius R, the box is 4 R wide with vapour at density 0.01
+  const double radius = std::cbrt(3.0 * drop / (4.0 * M_PI * 0.8));
+  const double side = 4.0 * radius;
+  const int vapour = static_cast<int>(0.01 * side * side * side);
+
+  LinkedCellContainer container(r_cutoff, {side, side, side});
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, side);
+  std::uniform_real_distribution<double> ball(-radius, radius);
+  for (int i = 0; i < vapour; ++i) {
+    container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+  }
+  for (int placed = 0; placed < drop;) {
+    const double x = ball(gen), y = ball(gen), z = ball(gen);
+    if (x * x + y * y + z * z > radius * radius) continue;
+    container.emplaceParticle({0.5 * side + x, 0.5 * side + y, 0.75 * side + z}, {0.0, 0.0, 0.0}, 1.0, 0);
+    ++placed;
+  }
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  std::printf("drop: %d, vapour: %d, cells per dimension: %.0f, hardware threads (OpenMP): %d\n", drop, vapour,
+              std::ceil(side / r_cutoff), parallel::maxThreads());
+  std::printf("%8s %14s %14s %12s\n", "threads", "Dynamic", "WorkStealing", "imbalance");
+
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    container.setNumThreads(threads);
+    double time[2];
+    for (const auto schedule : {CellSchedule::Dynamic, CellSchedule::WorkStealing}) {
+      container.setCellSchedule(schedule);
+      container.getScheduler().resetStats();
+      time[static_cast<int>(schedule)] = secondsPerStep([&] { force.calculateF(container); }, repetitions);
+    }
+
+    // imbalance of the work-stealing runs; a single thread runs the serial traversal without statistics
+    double most = 0.0, total = 0.0;
+    const auto &stats = container.getScheduler().getThreadStats();
+    for (const auto &s : stats) {
+      most = std::max(most, s.busySeconds);
+      total += s.busySeconds;
+    }
+    const double imbalance = threads > 1 && total > 0.0 ? most * static_cast<double>(stats.size()) / total : 1.0;
+    std::printf("%8d %11.3f ms %11.3f ms %12.3f\n", threads, 1e3 * time[0], 1e3 * time[1], imbalance);
+  }
+  return 0;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file ParallelStrategyBenchmark.cpp
+ * @brief Compares the parallel force accumulation strategies of the linked-cell container.
+ *
+ * Random gases of several densities are stored in linked-cell containers of equal particle count; for every
+ * density and thread count each strategy computes the truncated Lennard-Jones forces of the same configuration.
+ * The winner depends on the density (pairs per cell) and on the number of cores, so run it on the target node.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/Parallel.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 50000;
+  const int max_threads = argc > 2 ? std::atoi(argv[2]) : parallel::maxThreads();
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 5;
+
+  const TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  std::printf("particles: %d, hardware threads (OpenMP): %d\n", n, parallel::maxThreads());
+  std::printf("%8s %8s %14s %14s %14s %14s   (ms/step)\n", "density", "threads", "Coloring", "ThreadBuffers",
+              "FullShell", "Atomic");
+
+  for (const double density : {0.05, 0.3, 0.8}) {
+    const double side = std::cbrt(n / density);
+    LinkedCellContainer container(r_cutoff, {side, side, side});
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, side);
+    for (int i = 0; i < n; ++i) {
+      container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+    }
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+      container.setNumThreads(threads);
+      std::printf("%8.2f %8d", density, threads);
+      for (const auto strategy : {ParallelStrategy::Coloring, ParallelStrategy::ThreadBuffers,
+                                  ParallelStrategy::FullShell, ParallelStrategy::Atomic}) {
+        container.setParallelStrategy(strategy);
+        const double time = secondsPerStep(
+            [&] {
+              container.resetForces();
+              container.forEachPairForce(
+                  [&force](const Particle &p1, const Particle &p2) { return force.pairForce(p1, p2); });
+            },
+            repetitions);
+        std::printf(" %14.3f", 1e3 * time);
+      }
+      std::printf("\n");
+    }
+  }
+  return 0;
+}
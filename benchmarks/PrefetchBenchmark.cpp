@@ -0,0 +1,63 @@
+/**
+ * @file PrefetchBenchmark.cpp
+ * @brief Software prefetch distances of the linked-cell force traversal on scattered and sorted particles.
+ *
+ * A random gas is generated in random order, so neighboring particles lie far apart in memory and the traversal is
+ * bound by memory latency. The forces are timed for several prefetch distances, then again after distributeStorage()
+ * has put the particles into cell order.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/Parallel.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 500000;
+  const double density = argc > 2 ? std::atof(argv[2]) : 0.1;
+  const int threads = argc > 3 ? std::atoi(argv[3]) : parallel::maxThreads();
+  const int repetitions = argc > 4 ? std::atoi(argv[4]) : 5;
+
+  const double side = std::cbrt(n / density);
+  LinkedCellContainer container(r_cutoff, {side, side, side});
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, side);
+  for (int i = 0; i < n; ++i) {
+    container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+  }
+  container.setNumThreads(threads);
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  std::printf("particles: %d, density: %.2f, threads: %d\n", n, density, threads);
+  std::printf("%10s %10s %12s %10s\n", "storage", "distance", "ms/step", "speedup");
+  for (const char *storage : {"scattered", "sorted"}) {
+    double off = 0.0;
+    for (const int distance : {0, 1, 2, 4, 8}) {
+      container.setPrefetchDistance(distance);
+      const double time = secondsPerStep([&] { force.calculateF(container); }, repetitions);
+      if (distance == 0) off = time;
+      std::printf("%10s %10d %12.3f %10.2f\n", storage, distance, 1e3 * time, off / time);
+    }
+    container.distributeStorage();
+  }
+  return 0;
+}
@@ -0,0 +1,60 @@
+/**
+ * @file SparseDomainBenchmark.cpp
+ * @brief Times the force traversal of a dense block that fills only a small part of the domain.
+ *
+ * The same block of particles (density 0.8) sits in a corner of boxes of growing size, so 100%, 10% and 1% of the
+ * cells are occupied. Without skipping empty cells the traversal cost grows with the box; with it the cost should
+ * stay close to that of the filled box.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "utils/Parallel.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int n = argc > 1 ? std::atoi(argv[1]) : 20000;
+  const int threads = argc > 2 ? std::atoi(argv[2]) : 1;
+  const int repetitions = argc > 3 ? std::atoi(argv[3]) : 10;
+
+  const double block = std::cbrt(n / 0.8);
+  TruncatedShiftedLennardJones force(5.0, 1.0, r_cutoff);
+  std::printf("particles: %d, threads: %d, hardware threads (OpenMP): %d\n", n, threads, parallel::maxThreads());
+  std::printf("%8s %12s %14s %14s   (ms/step)\n", "fill", "cells", "forces", "rebuild");
+
+  for (const double fill : {1.0, 0.1, 0.01}) {
+    const double side = block / std::cbrt(fill);
+    LinkedCellContainer container(r_cutoff, {side, side, side});
+    container.setNumThreads(threads);
+    std::mt19937 gen(42);
+    std::uniform_real_distribution<double> dist(0.0, block);
+    for (int i = 0; i < n; ++i) {
+      container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+    }
+    container.rebuild();
+
+    const double forces = secondsPerStep([&] { force.calculateF(container); }, repetitions);
+    const double rebuild = secondsPerStep([&] { container.rebuild(); }, repetitions);
+    std::printf("%7.0f%% %12zu %14.3f %14.3f\n", 100.0 * fill, container.numCells(), 1e3 * forces, 1e3 * rebuild);
+  }
+  return 0;
+}
@@ -0,0 +1,102 @@
+/**
+ * @file StrongScalingBenchmark.cpp
+ * @brief Strong scaling of the colored OpenMP linked-cell force computation.
+ *
+ * The scene of a molecule YAML file (input/eingabe.yml by default) is scaled up by an integer factor in x and y:
+ * origins, disc centers and the domain grow by the factor, particle counts per dimension and disc radii as well, so
+ * the density stays the same and the particle count grows with its square. The forces of the same configuration are
+ * then computed with 1, 2, 4, ... threads.
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include "Container/LinkedCellContainer.h"
+#include "ForceCalculation/ForceCalculationFactory.h"
+#include "Generator/CuboidGenerator.h"
+#include "Generator/DiscGenerator.h"
+#include "inputReader/YamlInputReader.h"
+#include "utils/Parallel.h"
+
+namespace {
+void scaleScene(SimulationConfig &cfg, int factor) {
+  for (int d = 0; d < 2; ++d) {
+    cfg.domainSize[d] *= factor;
+    for (auto &c : cfg.cuboids) {
+      c.origin[d] *= factor;
+      c.numPerDim[d] *= factor;
+    }
+    for (auto &disc : cfg.discs) {
+      disc.center[d] *= factor;
+    }
+  }
+  for (auto &disc : cfg.discs) {
+    disc.radiusCells *= factor;
+  }
+}
+
+template <typename Step>
+double secondsPerStep(Step step, int repetitions) {
+  step();  // warm up buffers and caches
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < repetitions; ++i) {
+    step();
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const std::string input = argc > 1 ? argv[1] : "input/eingabe.yml";
+  const int factor = argc > 2 ? std::atoi(argv[2]) : 4;
+  const int max_threads = argc > 3 ? std::atoi(argv[3]) : 64;
+  const int repetitions = argc > 4 ? std::atoi(argv[4]) : 10;
+
+  auto cfg = YamlInputReader(input).parse();
+  scaleScene(cfg, factor);
+
+  LinkedCellContainer container(cfg.rCutoff, cfg.domainSize);
+  for (const auto &c : cfg.cuboids) {
+    CuboidGenerator::generateCuboid(container, c.origin, c.numPerDim, cfg.domainSize, c.h, c.mass, c.baseVelocity,
+                                    c.brownianMean, c.type);
+  }
+  for (const auto &d : cfg.discs) {
+    DiscGenerator::generateDisc(container, d.center, d.radiusCells, d.hDisc, d.mass, d.baseVelocity, d.typeDisc);
+  }
+  container.rebuild();
+  const auto force = ForceCalculationFactory::createForceCalculation(cfg);
+
+  std::printf("input: %s x%d, particles: %zu, hardware threads (OpenMP): %d\n", input.c_str(), factor,
+              container.size(), parallel::maxThreads());
+
+  // serial reference for the speedup and the force deviation
+  force->calculateF(container);
+  std::vector<std::array<double, 3>> reference;
+  for (auto &p : container) {
+    reference.push_back(p.getF());
+  }
+
+  double serial_time = 0.0;
+  std::printf("%8s %12s %10s %12s %14s\n", "threads", "ms/step", "speedup", "efficiency", "max |dF|");
+  for (int threads = 1; threads <= max_threads; threads *= 2) {
+    container.setNumThreads(threads);
+    const double time = secondsPerStep([&] { force->calculateF(container); }, repetitions);
+    if (threads == 1) serial_time = time;
+
+    double deviation = 0.0;
+    std::size_t i = 0;
+    for (auto &p : container) {
+      for (int d = 0; d < 3; ++d) {
+        deviation = std::max(deviation, std::abs(p.getF()[d] - reference[i][d]));
+      }
+      ++i;
+    }
+    std::printf("%8d %12.3f %10.2f %11.1f%% %14.3e\n", threads, 1e3 * time, serial_time / time,
+                100.0 * serial_time / time / threads, deviation);
+  }
+  return 0;
+}
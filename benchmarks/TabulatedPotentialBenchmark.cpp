@@ -0,0 +1,107 @@
+/**
+ * @file TabulatedPotentialBenchmark.cpp
+ * @brief Accuracy and throughput of tabulated pair potentials compared to the analytic LennardJones::calc.
+ *
+ * Accuracy is measured on a fine radial sweep inside the cutoff, throughput on random particle pairs with
+ * distances in [0.9 sigma, r_c) so that every pair interacts.
+ */
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "ForceCalculation/LennardJones.h"
+#include "ForceCalculation/TabulatedPotential.h"
+
+namespace {
+constexpr double epsilon = 5.0;
+constexpr double sigma = 1.0;
+constexpr double r_min = 0.8;
+constexpr double r_cutoff = 2.5;
+
+Particle particleAt(double x, double y, double z) {
+  Particle p;
+  p.setX({x, y, z});
+  p.setF({0.0, 0.0, 0.0});
+  return p;
+}
+
+template <typename PairForce>
+double pairsPerSecond(std::vector<Particle> &particles, PairForce force, int repetitions) {
+  const auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < repetitions; ++rep) {
+    for (std::size_t i = 0; i + 1 < particles.size(); i += 2) {
+      force(particles[i], particles[i + 1]);
+    }
+  }
+  const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  return static_cast<double>(repetitions) * static_cast<double>(particles.size() / 2) / elapsed.count();
+}
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int pairs = argc > 1 ? std::atoi(argv[1]) : 1000000;
+  const int repetitions = argc > 2 ? std::atoi(argv[2]) : 10;
+
+  LennardJones lj;
+  lj.setEpsilon(epsilon);
+  lj.setSigma(sigma);
+  Particle origin = particleAt(0.0, 0.0, 0.0);
+  Particle at_cutoff = particleAt(r_cutoff, 0.0, 0.0);
+  const double shift = lj.calculateU(origin, at_cutoff);
+
+  std::printf("accuracy against LennardJones::calc for r in [0.9, %.1f):\n", r_cutoff);
+  std::printf("%8s %16s %16s\n", "points", "max rel. |F|", "max abs. U");
+  for (const std::size_t points : {256, 1024, 4096, 16384}) {
+    const auto table = TabulatedPotential::lennardJones(epsilon, sigma, r_min, r_cutoff, points);
+    double force_error = 0.0;
+    double energy_error = 0.0;
+    for (double r = 0.9; r < r_cutoff; r += 1e-4) {
+      Particle a = particleAt(0.0, 0.0, 0.0), b = particleAt(r, 0.0, 0.0);
+      LennardJones::calc(a, b, epsilon, sigma);
+      double u, f_over_r;
+      table.evaluate(r * r, u, f_over_r);
+      // the force on a is f_over_r * (x_a - x_b) = -f_over_r * r
+      const double error = std::abs(-f_over_r * r - a.getF()[0]) / std::max(std::abs(a.getF()[0]), 1.0);
+      force_error = std::max(force_error, error);
+      energy_error = std::max(energy_error, std::abs(u - (lj.calculateU(a, b) - shift)));
+    }
+    std::printf("%8zu %16.3e %16.3e\n", points, force_error, energy_error);
+  }
+
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> distance(0.9, r_cutoff);
+  std::uniform_real_distribution<double> direction(-1.0, 1.0);
+  std::vector<Particle> particles;
+  particles.reserve(2 * static_cast<std::size_t>(pairs));
+  for (int i = 0; i < pairs; ++i) {
+    double dx, dy, dz, norm;
+    do {
+      dx = direction(gen);
+      dy = direction(gen);
+      dz = direction(gen);
+      norm = std::sqrt(dx * dx + dy * dy + dz * dz);
+    } while (norm < 1e-3 || norm > 1.0);
+    const double r = distance(gen) / norm;
+    particles.push_back(particleAt(0.0, 0.0, 0.0));
+    particles.push_back(particleAt(r * dx, r * dy, r * dz));
+  }
+
+  const auto lj_table = TabulatedPotential::lennardJones(epsilon, sigma, r_min, r_cutoff, 4096);
+  const auto morse_table = TabulatedPotential::morse(epsilon, 1.5, 1.1, r_min, r_cutoff, 4096);
+
+  std::printf("\nthroughput (%d pairs x %d repetitions):\n", pairs, repetitions);
+  const double analytic =
+      pairsPerSecond(particles, [](Particle &a, Particle &b) { LennardJones::calc(a, b, epsilon, sigma); }, repetitions);
+  std::printf("%-28s %14.3e pairs/s\n", "LennardJones::calc", analytic);
+  const double tabulated_lj =
+      pairsPerSecond(particles, [&lj_table](Particle &a, Particle &b) { lj_table.calc(a, b); }, repetitions);
+  std::printf("%-28s %14.3e pairs/s (x%.2f)\n", "tabulated Lennard-Jones", tabulated_lj, tabulated_lj / analytic);
+  const double tabulated_morse =
+      pairsPerSecond(particles, [&morse_table](Particle &a, Particle &b) { morse_table.calc(a, b); }, repetitions);
+  std::printf("%-28s %14.3e pairs/s (x%.2f)\n", "tabulated Morse", tabulated_morse, tabulated_morse / analytic);
+  return 0;
+}
@@ -0,0 +1,47 @@
+#include "CellLists.h"
+
+#include <algorithm>
+
+void CellLists::resize(std::size_t num_cells) {
+  offsets.assign(num_cells + 1, 0);
+  added.clear();
+  added_cell.clear();
+  by_cell.clear();
+  occupied_cells.clear();
+  built = true;
+}
+
+void CellLists::clear() {
+  std::fill(offsets.begin(), offsets.end(), 0);
+  added.clear();
+  added_cell.clear();
+  by_cell.clear();
+  occupied_cells.clear();
+  built = true;
+}
+
+void CellLists::build() {
+  if (built) return;
+
+  // first pass: count the particles of every cell, shifted by one so the prefix sum yields the start offsets
+  std::fill(offsets.begin(), offsets.end(), 0);
+  for (const auto cell : added_cell) {
+    ++offsets[cell + 1];
+  }
+  occupied_cells.clear();
+  for (std::size_t c = 1; c < offsets.size(); ++c) {
+    if (offsets[c] != 0) occupied_cells.push_back(c - 1);
+    offsets[c] += offsets[c - 1];
+  }
+
+  // second pass: scatter, offsets[c] runs from the start to the end of cell c and is shifted back afterwards
+  by_cell.resize(added.size());
+  for (std::size_t i = 0; i < added.size(); ++i) {
+    by_cell[offsets[added_cell[i]]++] = added[i];
+  }
+  for (std::size_t c = offsets.size() - 1; c > 0; --c) {
+    offsets[c] = offsets[c - 1];
+  }
+  offsets[0] = 0;
+  built = true;
+}
@@ -0,0 +1,180 @@
+/**
+ * @file CellLists.h
+ * @brief Particles of a cell grid in compressed sparse row (CSR) form.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Particle.h"
+#include "utils/HugePages.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Particle lists of all cells of a grid, stored as one contiguous array with per-cell offsets.
+ *
+ * Particles are added with their cell in any order; build() groups them by cell with a two-pass counting sort (count
+ * per cell, prefix sum into the offsets, scatter). Afterwards the particles of cell c are
+ * sorted()[start(c), start(c + 1)), in the order they were added. Adding particles invalidates the lists until the
+ * next build(). All buffers keep their capacity, so a rebuild every step allocates nothing once warmed up. The prefix
+ * sum also records the occupied cells, so traversals of sparse grids can skip the empty ones.
+ */
+class CellLists {
+ public:
+  /// The particles of one cell, a view into the sorted array.
+  class Range {
+   public:
+    Range(Particle *const *first, Particle *const *last) : first(first), last(last) {}
+    [[nodiscard]] auto begin() const -> Particle *const * { return first; }
+    [[nodiscard]] auto end() const -> Particle *const * { return last; }
+    [[nodiscard]] auto data() const -> Particle *const * { return first; }
+    [[nodiscard]] auto size() const -> std::size_t { return static_cast<std::size_t>(last - first); }
+    [[nodiscard]] auto empty() const -> bool { return first == last; }
+    auto operator[](std::size_t i) const -> Particle * { return first[i]; }
+
+   private:
+    Particle *const *first;
+    Particle *const *last;
+  };
+
+  /// Drop all particles and size the offsets for the given number of cells.
+  void resize(std::size_t num_cells);
+  /// Drop all particles, keeping the cells and the capacity.
+  void clear();
+  /// Stage a particle for the given cell; the lists are stale until build().
+  void add(Particle *particle, std::size_t cell) {
+    added.push_back(particle);
+    added_cell.push_back(cell);
+    built = false;
+  }
+  /// Sort the staged particles by cell; does nothing if nothing was added since the last build.
+  void build();
+  /**
+   * @brief Replace all particles by particle(i) in cell cell_of[i] for every i < n with keep(cell_of[i]), built.
+   *
+   * Parallel counting sort: every thread counts its contiguous chunk of i into its own histogram, an exclusive
+   * prefix sum over (cell, thread) turns the histograms into write offsets, and every thread scatters its chunk.
+   * The result is the same as adding the particles in the order of i and calling build().
+   */
+  template <typename ParticleAt, typename Keep>
+  void assign(std::size_t n, ParticleAt particle, const std::size_t *cell_of, Keep keep, int threads);
+
+  [[nodiscard]] auto isBuilt() const noexcept -> bool { return built; }
+  [[nodiscard]] auto numCells() const noexcept -> std::size_t { return offsets.size() - 1; }
+  /// Number of particles in all cells.
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return added.size(); }
+  /// All particles in the order they were added.
+  [[nodiscard]] auto particles() const -> const LargeVector<Particle *> & { return added; }
+  /// Offset of the first particle of a cell in the sorted array; start(numCells()) is the particle count.
+  [[nodiscard]] auto start(std::size_t cell) const -> std::size_t { return offsets[cell]; }
+  /// All particles grouped by cell (valid after build()).
+  [[nodiscard]] auto sorted() const -> const LargeVector<Particle *> & { return by_cell; }
+  /// Cells holding at least one particle, ascending (valid after build()).
+  [[nodiscard]] auto occupied() const -> const std::vector<std::size_t> & { return occupied_cells; }
+  /// Particles of a cell (valid after build()).
+  [[nodiscard]] auto cell(std::size_t cell) const -> Range {
+    return {by_cell.data() + offsets[cell], by_cell.data() + offsets[cell + 1]};
+  }
+
+ private:
+  LargeVector<Particle *> added;             ///< Staged particles in insertion order.
+  LargeVector<std::size_t> added_cell;       ///< Cell of every staged particle.
+  LargeVector<std::size_t> offsets{0};       ///< numCells() + 1 offsets into by_cell.
+  LargeVector<Particle *> by_cell;           ///< Staged particles sorted by cell.
+  LargeVector<std::uint32_t> thread_counts;  ///< Per-thread histograms of assign(), then offsets within the cells.
+  std::vector<std::size_t> thread_begin;     ///< First staged slot of every thread in assign().
+  std::vector<std::size_t> occupied_cells;   ///< Non-empty cells, ascending.
+  bool built{true};
+};
+
+template <typename ParticleAt, typename Keep>
+void CellLists::assign(std::size_t n, ParticleAt particle, const std::size_t *cell_of, Keep keep, int threads) {
+  const auto num_cells = numCells();
+  threads = std::max(1, threads);
+  thread_counts.resize(static_cast<std::size_t>(threads) * num_cells);
+  thread_begin.assign(static_cast<std::size_t>(threads) + 1, 0);
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) if (threads > 1)
+#endif
+  {
+#ifdef _OPENMP
+    const auto team = static_cast<std::size_t>(omp_get_num_threads());
+    const auto thread = static_cast<std::size_t>(omp_get_thread_num());
+#else
+    const std::size_t team = 1;
+    const std::size_t thread = 0;
+#endif
+    const auto begin = n * thread / team;
+    const auto end = n * (thread + 1) / team;
+    auto *counts = thread_counts.data() + thread * num_cells;
+
+    // first pass: histogram of the own chunk
+    std::fill(counts, counts + num_cells, 0);
+    std::size_t kept = 0;
+    for (auto i = begin; i < end; ++i) {
+      if (keep(cell_of[i])) {
+        ++counts[cell_of[i]];
+        ++kept;
+      }
+    }
+    thread_begin[thread + 1] = kept;
+#ifdef _OPENMP
+#pragma omp barrier
+#pragma omp single
+#endif
+    {
+      for (std::size_t t = 0; t < team; ++t) {
+        thread_begin[t + 1] += thread_begin[t];
+      }
+      added.resize(thread_begin[team]);
+      added_cell.resize(thread_begin[team]);
+      by_cell.resize(thread_begin[team]);
+    }
+
+    // the threads of a cell write one after another: exclusive prefix over the threads, cell sizes into offsets
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (std::size_t c = 0; c < num_cells; ++c) {
+      std::size_t size = 0;
+      for (std::size_t t = 0; t < team; ++t) {
+        auto &count = thread_counts[t * num_cells + c];
+        const auto own = count;
+        count = static_cast<std::uint32_t>(size);
+        size += own;
+      }
+      offsets[c + 1] = size;
+    }
+#ifdef _OPENMP
+#pragma omp single
+#endif
+    {
+      offsets[0] = 0;
+      occupied_cells.clear();
+      for (std::size_t c = 0; c < num_cells; ++c) {
+        if (offsets[c + 1] != 0) occupied_cells.push_back(c);
+        offsets[c + 1] += offsets[c];
+      }
+    }
+
+    // second pass: scatter the own chunk, in order
+    auto slot = thread_begin[thread];
+    for (auto i = begin; i < end; ++i) {
+      const auto cell = cell_of[i];
+      if (!keep(cell)) continue;
+      auto *p = particle(i);
+      added[slot] = p;
+      added_cell[slot] = cell;
+      ++slot;
+      by_cell[offsets[cell] + counts[cell]++] = p;
+    }
+  }
+  built = true;
+}
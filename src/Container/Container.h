@@ -55,6 +55,8 @@ class Container {
  public:
   using iterator = ParticleIterator;
   using const_iterator = ConstParticleIterator;
+  /// Force on the first particle of a pair; the second particle receives the opposite force.
+  using PairForce = std::function<std::array<double, 3>(const Particle &, const Particle &)>;
 
   Container() = default;
   virtual ~Container() = default;
@@ -77,6 +79,39 @@ class Container {
   virtual auto emplaceParticle(const std::array<double, 3> &pos, const std::array<double, 3> &vel, double mass,
                                int type) -> Particle & = 0;
 
+  /**
+   * @brief Apply visitor to every particle.
+   *
+   * Containers may call the visitor concurrently for different particles, so it must only modify the particle.
+   */
+  virtual auto forEachParticle(const std::function<void(Particle &)> &visitor) -> void {
+    for (auto &p : *this) {
+      visitor(p);
+    }
+  }
+
+  /// Set the forces of all particles to zero; containers may defer the work to their next pair traversal.
+  virtual auto resetForces() -> void {
+    forEachParticle([](Particle &p) { p.setF({0., 0., 0.}); });
+  }
+
   /// Iterate all unordered particle pairs.
   virtual auto forEachPair(const std::function<void(Particle &, Particle &)> &visitor) -> void = 0;
+  /**
+   * @brief Add the force of pair_force to both particles of every unordered pair (Newton's third law).
+   *
+   * Unlike forEachPair the container decides how the forces are accumulated, which lets parallel containers use
+   * per-thread buffers or atomics. pair_force must not modify shared state.
+   */
+  virtual auto forEachPairForce(const PairForce &pair_force) -> void {
+    forEachPair([&pair_force](Particle &p, Particle &q) {
+      const auto force = pair_force(p, q);
+      auto &fp = p.getF();
+      auto &fq = q.getF();
+      for (int d = 0; d < 3; ++d) {
+        fp[d] += force[d];
+        fq[d] -= force[d];
+      }
+    });
+  }
 };
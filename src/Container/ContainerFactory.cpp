@@ -1,15 +1,56 @@
 #include "ContainerFactory.h"
 
+#include <spdlog/spdlog.h>
+
 #include "LinkedCellContainer.h"
 #include "ParticleContainer.h"
+#include "utils/Parallel.h"
+
+#ifdef MOLSIM_ENABLE_MPI
+#include "Decomposition/MpiTransport.h"
+#endif
+
+namespace {
+void configureTraversal(LinkedCellContainer &container, const SimulationConfig &cfg, int threads) {
+  container.setNumThreads(threads);
+  container.setParallelStrategy(cfg.parallelStrategy);
+  container.setCellSchedule(cfg.cellSchedule);
+  container.setCellTraversal(cfg.cellTraversal);
+  container.setPrefetchDistance(cfg.prefetchDistance);
+}
+}  // namespace
 
 namespace ContainerFactory {
 auto createContainer(SimulationConfig &cfg) -> std::unique_ptr<Container> {
   switch (cfg.containerType) {
-    case ContainerType::Cell:
-      return std::make_unique<LinkedCellContainer>(cfg.rCutoff, cfg.domainSize);
+    case ContainerType::Cell: {
+      std::unique_ptr<LinkedCellContainer> container;
+#ifdef MOLSIM_ENABLE_MPI
+      auto transport = std::make_unique<MpiTransport>();
+      if (transport->size() > 1) {
+        container = createDecomposedContainer(cfg, std::move(transport));
+      }
+#endif
+      if (!container) {
+        container = std::make_unique<LinkedCellContainer>(cfg.rCutoff, cfg.domainSize);
+      }
+      configureTraversal(*container, cfg, parallel::resolveThreadCount(cfg.numThreads));
+      SPDLOG_INFO("Linked-cell traversal uses {} thread(s), strategy {}.", container->getNumThreads(),
+                  parallelStrategyName(container->getParallelStrategy()));
+      return container;
+    }
     case ContainerType::Particle:
       return std::make_unique<ParticleContainer>();
   }
 }
+
+auto createDecomposedContainer(const SimulationConfig &cfg, std::unique_ptr<Transport> transport)
+    -> std::unique_ptr<DecomposedContainer> {
+  const auto dims = DomainDecomposition::createDims(transport->size(), cfg.rankDims, cfg.domainSize, cfg.rCutoff);
+  const DomainDecomposition decomposition(transport->rank(), dims,
+                                          LinkedCellContainer::defaultDomainMin(cfg.domainSize), cfg.domainSize);
+  auto container = std::make_unique<DecomposedContainer>(cfg.rCutoff, decomposition, std::move(transport));
+  configureTraversal(*container, cfg, 1);
+  return container;
+}
 }  // namespace ContainerFactory
@@ -4,8 +4,11 @@
  */
 #pragma once
 
+#include <memory>
+
 #include "../inputReader/SimulationConfig.h"
 #include "Container.h"
+#include "Decomposition/DecomposedContainer.h"
 
 namespace ContainerFactory {
 /**
@@ -14,4 +17,12 @@ namespace ContainerFactory {
  * @return a new container of the specified type
  */
 std::unique_ptr<Container> createContainer(SimulationConfig &cfg);
+/**
+ * @brief Linked-cell container for the sub-box of one rank; the rank grid follows parallel.ranks.
+ * @param cfg Simulation configuration
+ * @param transport Messages between the ranks, its rank and size define the sub-box
+ * @return a container with a serial traversal
+ */
+std::unique_ptr<DecomposedContainer> createDecomposedContainer(const SimulationConfig &cfg,
+                                                               std::unique_ptr<Transport> transport);
 }  // namespace ContainerFactory
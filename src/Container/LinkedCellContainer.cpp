@@ -6,20 +6,29 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
 #include <iostream>
 
 LinkedCellContainer::LinkedCellContainer() : LinkedCellContainer(1.0, {1.0, 1.0, 1.0}) {}
 
 LinkedCellContainer::LinkedCellContainer(double r_cutoff, const std::array<double, 3> &domain_size)
-    : r_cutoff(r_cutoff), domain_size(domain_size) {
-  domain_min.fill(0.0);
+    : LinkedCellContainer(r_cutoff, defaultDomainMin(domain_size), domain_size) {}
+
+LinkedCellContainer::LinkedCellContainer(double r_cutoff, const std::array<double, 3> &domain_min,
+                                         const std::array<double, 3> &domain_size)
+    : r_cutoff(r_cutoff), domain_size(domain_size), domain_min(domain_min) {
+  initDimensions();
+  initCells();
+}
+
+auto LinkedCellContainer::defaultDomainMin(const std::array<double, 3> &domain_size) -> std::array<double, 3> {
+  std::array<double, 3> domain_min{0.0, 0.0, 0.0};
   // If the domain collapses to a single cell along z, center the cell on z = 0
   // so generated particles do not sit directly on the lower wall.
   if (std::abs(domain_size.at(2) - 1.0) < 1e-9) {
     domain_min.at(2) = -0.5 * domain_size.at(2);
   }
-  initDimensions();
-  initCells();
+  return domain_min;
 }
 
 void LinkedCellContainer::setBoundaryConditions(const std::array<BoundaryCondition, 6> &conditions) {
@@ -30,6 +39,124 @@ auto LinkedCellContainer::getBoundaryConditions() const -> const std::array<Boun
   return boundary_conditions;
 }
 
+void LinkedCellContainer::setNumThreads(int threads) { num_threads = std::max(1, threads); }
+
+void LinkedCellContainer::setCellTraversal(CellTraversal traversal) {
+  cell_traversal = traversal;
+  buildColors();
+  tasks_valid = false;
+  pairs_stale = true;
+}
+
+auto LinkedCellContainer::taskCost(std::size_t task) -> double {
+  double cost = 0.0;
+  for (auto pair = task_pair_start[task]; pair < task_pair_start[task + 1]; ++pair) {
+    const auto [a, b] = cell_pairs[pair];
+    const auto n = static_cast<double>(cellRange(a).size());
+    // the self pair also stands for the force reset of the cell
+    pair_costs[pair] = a == b ? n + 0.5 * n * (n - 1.0) : n * static_cast<double>(cellRange(b).size());
+    cost += pair_costs[pair];
+  }
+  return cost;
+}
+
+void LinkedCellContainer::touchAllCells() {
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static)
+#endif
+  for (std::size_t i = 0; i < occupied_cells.size(); ++i) {
+    touchCell(occupied_cells[i]);
+  }
+}
+
+void LinkedCellContainer::updateTasks() {
+  tasks_valid = true;
+  const auto &owned = owned_lists.occupied();
+  const auto &halo = halo_lists.occupied();
+  std::vector<std::size_t> occupied(owned.size() + halo.size());
+  std::merge(owned.begin(), owned.end(), halo.begin(), halo.end(), occupied.begin());
+  if (!pairs_stale && occupied == occupied_cells) return;
+  occupied_cells.swap(occupied);
+  pairs_stale = false;
+  neighbors_valid = false;
+  ++pair_generation;
+
+  // candidate tasks: the occupied cells, or for the eighth shell every block with one of its eight cells occupied (a
+  // block reaches one cell forward along every axis)
+  std::vector<std::size_t> candidates;
+  if (cell_traversal == CellTraversal::HalfShell) {
+    candidates = occupied_cells;
+  } else {
+    for (const auto linear : occupied_cells) {
+      const auto c = to3DIndex(linear);
+      for (std::size_t corner = 0; corner < 8; ++corner) {
+        const std::array<std::size_t, 3> back{corner & 1, (corner >> 1) & 1, (corner >> 2) & 1};
+        if (back[0] > c[0] || back[1] > c[1] || back[2] > c[2]) continue;
+        const auto base = toLinearIndex(c[0] - back[0], c[1] - back[1], c[2] - back[2], padded_dims);
+        if (!task_marks[base]) {
+          task_marks[base] = 1;
+          candidates.push_back(base);
+        }
+      }
+    }
+    std::sort(candidates.begin(), candidates.end());
+    for (const auto base : candidates) {
+      task_marks[base] = 0;
+    }
+  }
+
+  // the stencil is evaluated once here; a task is kept if it pairs two occupied cells
+  active_cells.clear();
+  cell_pairs.clear();
+  task_pair_start.assign(1, 0);
+  for (const auto linear : candidates) {
+    forEachTaskPair(linear, [&](std::size_t a, std::size_t b) {
+      if (!cellRange(a).empty() && !cellRange(b).empty()) cell_pairs.push_back({a, b});
+    });
+    if (cell_pairs.size() > task_pair_start.back()) {
+      active_cells.push_back(linear);
+      task_pair_start.push_back(cell_pairs.size());
+    }
+  }
+  pair_costs.assign(cell_pairs.size(), 0.0);
+
+  color_tasks.resize(color_cells.size());
+  for (auto &color : color_tasks) {
+    color.clear();
+  }
+  for (std::size_t task = 0; task < active_cells.size(); ++task) {
+    color_tasks[colorOf(active_cells[task])].push_back(task);
+  }
+}
+
+void LinkedCellContainer::updateNeighbors() {
+  // the full 27-cell stencil, independent of the traversal and of the faces owned by neighbors; the loop order keeps
+  // the neighbors ascending
+  const int cells_x = static_cast<int>(padded_dims[0]);
+  const int cells_y = static_cast<int>(padded_dims[1]);
+  const int cells_z = static_cast<int>(padded_dims[2]);
+  neighbor_start.assign(1, 0);
+  cell_neighbors.clear();
+  for (const auto linear : occupied_cells) {
+    const auto coords = to3DIndex(linear);
+    for (int dz = -1; dz <= 1; ++dz) {
+      for (int dy = -1; dy <= 1; ++dy) {
+        for (int dx = -1; dx <= 1; ++dx) {
+          const int nx = static_cast<int>(coords[0]) + dx;
+          const int ny = static_cast<int>(coords[1]) + dy;
+          const int nz = static_cast<int>(coords[2]) + dz;
+          if (nx < 0 || ny < 0 || nz < 0 || nx >= cells_x || ny >= cells_y || nz >= cells_z) continue;
+          const auto neighbor = toLinearIndex(static_cast<std::size_t>(nx), static_cast<std::size_t>(ny),
+                                              static_cast<std::size_t>(nz), padded_dims);
+          if (!cellRange(neighbor).empty()) cell_neighbors.push_back(neighbor);
+        }
+      }
+    }
+    neighbor_start.push_back(cell_neighbors.size());
+  }
+  neighbors_valid = true;
+}
+
 void LinkedCellContainer::initDimensions() {
   for (int i = 0; i < 3; ++i) {
     if (domain_size.at(i) > 0) {
@@ -51,6 +178,12 @@ void LinkedCellContainer::initCells() {
   const std::size_t total_cells = computeTotalCells(padded_dims);
   cells.clear();
   cells.reserve(total_cells);
+  cell_epoch.assign(total_cells, force_epoch);
+  task_marks.assign(total_cells, 0);
+  tasks_valid = false;
+  pairs_stale = true;
+  owned_lists.resize(total_cells);
+  halo_lists.resize(total_cells);
   halo_cells.clear();
   boundary_cells.clear();
 
@@ -71,32 +204,73 @@ void LinkedCellContainer::initCells() {
           cell.type = CellType::Inner;
         }
 
-        cells.push_back(std::move(cell));
-        auto *stored = &cells.back();
-        if (stored->type == CellType::Halo) {
-          halo_cells.push_back(stored);
-        } else if (stored->type == CellType::Boundary) {
-          boundary_cells.push_back(stored);
+        if (cell.type == CellType::Halo) {
+          halo_cells.push_back(cells.size());
+        } else if (cell.type == CellType::Boundary) {
+          boundary_cells.push_back(cells.size());
         }
+        cells.push_back(cell);
       }
     }
   }
+  buildColors();
+}
+
+void LinkedCellContainer::buildColors() {
+  // half-stencil tasks span 2 x 3 x 3 cells, eighth-shell blocks 2 x 2 x 2
+  color_cells.assign(cell_traversal == CellTraversal::EighthShell ? 8 : 18, {});
+  for (std::size_t linear = 0; linear < cells.size(); ++linear) {
+    color_cells[colorOf(linear)].push_back(linear);
+  }
+
+  // tasks pairing a halo cell have to wait for the ghosts in the overlapped rebuildWithPairForces
+  interior_color_cells.assign(color_cells.size(), {});
+  halo_color_cells.assign(color_cells.size(), {});
+  for (std::size_t color = 0; color < color_cells.size(); ++color) {
+    for (const auto linear : color_cells[color]) {
+      bool halo = false;
+      forEachTaskPair(linear, [&](std::size_t a, std::size_t b) {
+        halo = halo || cells[a].type == CellType::Halo || cells[b].type == CellType::Halo;
+      });
+      (halo ? halo_color_cells : interior_color_cells)[color].push_back(linear);
+    }
+  }
+}
+
+auto LinkedCellContainer::colorOf(std::size_t linear) const -> std::size_t {
+  const auto c = to3DIndex(linear);
+  if (cell_traversal == CellTraversal::EighthShell) {
+    return (c[0] % 2) + 2 * (c[1] % 2) + 4 * (c[2] % 2);
+  }
+  return (c[0] % 2) + 2 * (c[1] % 3) + 6 * (c[2] % 3);
 }
 
 void LinkedCellContainer::deleteHaloCells() {
-  std::vector<Particle *> to_delete;
-  to_delete.reserve(size());
-  for (auto *cell : halo_cells) {
-    to_delete.insert(to_delete.end(), cell->particles.begin(), cell->particles.end());
-    cell->particles.clear();
+  const auto &halo = halo_lists.particles();
+  std::vector<Particle *> to_delete(halo.begin(), halo.end());
+  halo_lists.clear();
+  tasks_valid = false;
+  if (to_delete.empty()) return;
+
+  // mark the outflowing particles in parallel chunks, then compact the storage in one serial pass
+  std::sort(to_delete.begin(), to_delete.end());
+  const auto n = owned_particles.size();
+  std::vector<char> outflow(n);
+#ifdef _OPENMP
+  // serial inside the boundary task of rebuildWithPairForces
+#pragma omp parallel for num_threads(num_threads) schedule(static) if (num_threads > 1 && !omp_in_parallel())
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    outflow[i] = std::binary_search(to_delete.begin(), to_delete.end(), owned_particles[i].get());
   }
 
-  owned_particles.erase(std::remove_if(owned_particles.begin(), owned_particles.end(),
-                                       [&](const auto &ptr) -> bool {
-                                         return std::find(to_delete.begin(), to_delete.end(), ptr.get()) !=
-                                                to_delete.end();
-                                       }),
-                        owned_particles.end());
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < n; ++i) {
+    if (!outflow[i]) {
+      owned_particles[kept++] = std::move(owned_particles[i]);
+    }
+  }
+  owned_particles.resize(kept);
 }
 
 auto LinkedCellContainer::addParticle(Particle &particle) -> Particle & {
@@ -127,33 +301,143 @@ auto LinkedCellContainer::reserve(std::size_t capacity) -> void { owned_particle
 
 auto LinkedCellContainer::clear() noexcept -> void {
   owned_particles.clear();
-  for (auto &cell : cells) {
-    cell.particles.clear();
-  }
+  clearCellLists();
 }
 
-void LinkedCellContainer::rebuild() {
-  ghost_particles.clear();  // drop ghosts from previous step
-  for (auto &cell : cells) {
-    cell.particles.clear();
-  }
-
-  for (auto &p : owned_particles) {
-    placeParticle(p.get());
-  }
+void LinkedCellContainer::rebuild() { rebuild([](Particle &) {}); }
 
+void LinkedCellContainer::finishRebuild() {
   deleteHaloCells();
 
+  // The boundary layers of all reflecting faces are collected first, so the contiguous ghost storage is sized once
+  // and the cells can point into it.
+  owned_lists.build();
   static constexpr std::array<Face, 6> faces{Face::XMin, Face::XMax, Face::YMin, Face::YMax, Face::ZMin, Face::ZMax};
+  std::array<std::vector<Particle *>, 6> layers;
+  std::size_t ghosts = 0;
   for (std::size_t i = 0; i < faces.size(); ++i) {
     if (boundary_conditions.at(i) == BoundaryCondition::Reflecting) {
-      createGhostsForFace(faces.at(i));
+      collectBoundaryLayer(faces.at(i), layers.at(i));
+      ghosts += layers.at(i).size();
     }
   }
 
+  ghost_particles.resize(ghosts);
+  std::size_t offset = 0;
+  for (std::size_t i = 0; i < faces.size(); ++i) {
+    createGhostsForFace(faces.at(i), layers.at(i), offset);
+    offset += layers.at(i).size();
+  }
+  for (auto &ghost : ghost_particles) {
+    placeGhost(ghost);
+  }
+  halo_lists.build();
+
   // logParticleCounts();
 }
 
+void LinkedCellContainer::rebuildWithPairForces(const std::function<void(Particle &)> &update,
+                                                const PairForce &pair_force) {
+#ifdef _OPENMP
+  // work stealing deals out the cached pair tasks of all colors, so it keeps the plain rebuild and traversal
+  if (num_threads > 1 && parallel_strategy == ParallelStrategy::Coloring && cell_schedule == CellSchedule::Dynamic) {
+    ghost_particles.clear();
+    binOwnedParticles(update);
+
+    auto accumulate = [&](std::size_t a, std::size_t b) {
+      const auto a_particles = cellRange(a);
+      const auto b_particles = cellRange(b);
+      auto add = [&](std::size_t i, std::size_t j) {
+        const auto force = pair_force(*a_particles[i], *b_particles[j]);
+        auto &fp = a_particles[i]->getF();
+        auto &fq = b_particles[j]->getF();
+        for (int d = 0; d < 3; ++d) {
+          fp[d] += force[d];
+          fq[d] -= force[d];
+        }
+      };
+      visitParticlePairs(a, b, add);
+    };
+    std::exception_ptr error;
+    // the tasks of one color in chunks; the taskgroup separates the colors but not the boundary task
+    auto run_color = [&](const std::vector<std::size_t> &color) {
+#pragma omp taskgroup
+      for (std::size_t begin = 0; begin < color.size(); begin += overlap_task_cells) {
+        const auto end = std::min(begin + overlap_task_cells, color.size());
+#pragma omp task firstprivate(begin, end) shared(color, error, accumulate)
+        for (std::size_t i = begin; i < end; ++i) {
+          // the active cells are not known before the ghosts exist, an empty half-shell task is skipped here
+          if (cell_traversal == CellTraversal::HalfShell && cellRange(color[i]).empty()) continue;
+          guarded(error, [&] { visitCellPairs(color[i], accumulate, i + 1 < end ? color[i + 1] : no_cell); });
+        }
+      }
+    };
+
+#pragma omp parallel num_threads(num_threads)
+#pragma omp single
+    {
+      // interior tasks only read the owned cell lists and never touch a halo cell or a force the ghosts are built from
+#pragma omp task shared(error)
+      guarded(error, [&] { finishRebuild(); });
+      for (const auto &color : interior_color_cells) {
+        run_color(color);
+      }
+#pragma omp taskwait
+      for (const auto &color : halo_color_cells) {
+        run_color(color);
+      }
+    }
+    if (error) std::rethrow_exception(error);
+    finishPairForces();
+    return;
+  }
+#endif
+
+  rebuild(update);
+  forEachPairForce(pair_force);
+}
+
+void LinkedCellContainer::distributeStorage() {
+  // cell order, so the static chunks of forEachParticle are compact in space as well
+  const auto n = owned_particles.size();
+  std::vector<std::size_t> cell_of(n);
+  std::vector<std::size_t> order(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    cell_of[i] = cellIndexOf(owned_particles[i]->getX());
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return cell_of[a] < cell_of[b]; });
+
+  // every copy is allocated and written by the thread whose chunk it is in, so its pages are first touched there
+  LargeVector<std::unique_ptr<Particle>> copies(n);
+  const bool huge_pages = memory::hugePageMode() != HugePageMode::None;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(num_threads) if (num_threads > 1)
+#endif
+  {
+    // the particles of one thread come from its malloc arena; their range is advised for transparent huge pages
+    std::uintptr_t lowest = UINTPTR_MAX;
+    std::uintptr_t highest = 0;
+#ifdef _OPENMP
+#pragma omp for schedule(static)
+#endif
+    for (std::size_t i = 0; i < n; ++i) {
+      copies[i] = std::make_unique<Particle>(*owned_particles[order[i]]);
+      const auto address = reinterpret_cast<std::uintptr_t>(copies[i].get());
+      lowest = std::min(lowest, address);
+      highest = std::max(highest, address + sizeof(Particle));
+    }
+    if (huge_pages && highest > lowest) {
+      memory::adviseHugePages(reinterpret_cast<const void *>(lowest), highest - lowest);
+    }
+  }
+  owned_particles.swap(copies);
+
+  ghost_particles.clear();
+  auto keep = [](Particle &) {};
+  binOwnedParticles(keep);
+}
+
 auto LinkedCellContainer::begin() -> iterator {
   return {[this](std::size_t idx) -> Particle * { return owned_particles[idx].get(); }, 0};
 }
@@ -175,14 +459,32 @@ auto LinkedCellContainer::cbegin() const -> const_iterator { return begin(); }
 auto LinkedCellContainer::cend() const -> const_iterator { return end(); }
 
 void LinkedCellContainer::placeParticle(Particle *particle) {
-  const auto &pos = particle->getX();
+  const auto cell = cellIndexOf(particle->getX());
+  (cells[cell].type == CellType::Halo ? halo_lists : owned_lists).add(particle, cell);
+  tasks_valid = false;
+}
+
+auto LinkedCellContainer::cellIndexOf(const std::array<double, 3> &pos) const -> std::size_t {
+  // branch-free clamp and select, so the binning sweep has no data-dependent branches
+  std::array<std::size_t, 3> idx{};
+  for (std::size_t i = 0; i < 3; ++i) {
+    const double shifted = pos[i] - domain_min[i];
+    const double last_cell = static_cast<double>(cells_per_dim[i] - 1);
+    const double raw = std::min(std::max(shifted / cell_dim[i], 0.0), last_cell);
+    const auto inside = static_cast<std::size_t>(raw) + 1;
+    idx[i] = shifted < 0.0 ? 0 : (shifted > domain_size[i] ? padded_dims[i] - 1 : inside);
+  }
+
+  return toLinearIndex(idx[0], idx[1], idx[2], padded_dims);
+}
 
+auto LinkedCellContainer::haloCellIndexOf(const std::array<double, 3> &pos) const -> std::size_t {
   std::array<std::size_t, 3> idx{};
   for (int i = 0; i < 3; ++i) {
     const double shifted = pos.at(i) - domain_min.at(i);
-    if (shifted < 0.0) {
+    if (shifted <= 0.0) {
       idx.at(i) = 0;
-    } else if (shifted > domain_size.at(i)) {
+    } else if (shifted >= domain_size.at(i)) {
       idx.at(i) = padded_dims.at(i) - 1;
     } else {
       const auto raw = static_cast<std::size_t>(shifted / cell_dim.at(i));
@@ -190,7 +492,7 @@ void LinkedCellContainer::placeParticle(Particle *particle) {
     }
   }
 
-  cells[toLinearIndex(idx[0], idx[1], idx[2], padded_dims)].particles.push_back(particle);
+  return toLinearIndex(idx[0], idx[1], idx[2], padded_dims);
 }
 
 auto LinkedCellContainer::to3DIndex(std::size_t linear_index) const -> std::array<std::size_t, 3> {
@@ -206,16 +508,16 @@ void LinkedCellContainer::logParticleCounts() const {
   std::size_t boundary = 0;
   std::size_t inner = 0;
 
-  for (const auto &cell : cells) {
-    switch (cell.type) {
+  for (std::size_t c = 0; c < cells.size(); ++c) {
+    switch (cells[c].type) {
       case CellType::Halo:
-        halo += cell.particles.size();
+        halo += cellRange(c).size();
         break;
       case CellType::Boundary:
-        boundary += cell.particles.size();
+        boundary += cellRange(c).size();
         break;
       case CellType::Inner:
-        inner += cell.particles.size();
+        inner += cellRange(c).size();
         break;
     }
   }
@@ -223,47 +525,42 @@ void LinkedCellContainer::logParticleCounts() const {
   std::cout << "Particle counts - inner: " << inner << ", boundary: " << boundary << ", halo: " << halo << "\n";
 }
 
-void LinkedCellContainer::createGhostsForFace(Face face) {
-  const auto bc = boundary_conditions.at(static_cast<std::size_t>(face));
-  if (bc != BoundaryCondition::Reflecting) {
-    return;
-  }
-
+void LinkedCellContainer::collectBoundaryLayer(Face face, std::vector<Particle *> &layer) {
   const auto axis = axisFromFace(face);
-  const bool upper = isUpper(face);
-  const auto boundary_coord = upper ? padded_dims.at(axis) - 2 : 1;
-
-  std::vector<Particle *> candidates;
+  const auto boundary_coord = isUpper(face) ? padded_dims.at(axis) - 2 : 1;
 
-  // Collect particles first to avoid mutating cell storage while iterating it.
-  for (auto *cell : boundary_cells) {
-    const auto linear_index = static_cast<std::size_t>(cell - cells.data());
+  for (const auto linear_index : boundary_cells) {
     const auto coords = to3DIndex(linear_index);
     if (coords.at(axis) != boundary_coord) {
       continue;
     }
-    candidates.insert(candidates.end(), cell->particles.begin(), cell->particles.end());
+    const auto particles = owned_lists.cell(linear_index);
+    layer.insert(layer.end(), particles.begin(), particles.end());
   }
+}
 
-  for (auto *particle : candidates) {
-    ghost_particles.push_back(std::make_unique<Particle>(*particle));
-    auto *ghost = ghost_particles.back().get();
-
-    auto ghost_pos = ghost->getX();
-    auto ghost_vel = ghost->getV();
-
-    const double lower_bound = domain_min.at(axis);
-    const double upper_bound = lower_bound + domain_size.at(axis);
-
+void LinkedCellContainer::createGhostsForFace(Face face, const std::vector<Particle *> &layer, std::size_t offset) {
+  const auto axis = axisFromFace(face);
+  const bool upper = isUpper(face);
+  const double lower_bound = domain_min.at(axis);
+  const double upper_bound = lower_bound + domain_size.at(axis);
+
+  const auto n = layer.size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static) if (num_threads > 1 && !omp_in_parallel())
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    // the force of the original is not read: interior tasks may be writing it concurrently
+    const auto &original = *layer[i];
+    auto ghost_pos = original.getX();
+    auto ghost_vel = original.getV();
     if (upper) {
-      ghost_pos.at(axis) = upper_bound + (upper_bound - ghost_pos.at(axis));
+      ghost_pos[axis] = upper_bound + (upper_bound - ghost_pos[axis]);
     } else {
-      ghost_pos.at(axis) = lower_bound - (ghost_pos.at(axis) - lower_bound);
+      ghost_pos[axis] = lower_bound - (ghost_pos[axis] - lower_bound);
     }
-    ghost_vel.at(axis) = -ghost_vel.at(axis);
+    ghost_vel[axis] = -ghost_vel[axis];
 
-    ghost->setX(ghost_pos);
-    ghost->setV(ghost_vel);
-    placeParticle(ghost);
+    ghost_particles[offset + i] = Particle(ghost_pos, ghost_vel, original.getM(), original.getType());
   }
 }
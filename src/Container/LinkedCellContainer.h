@@ -3,8 +3,8 @@
  * @brief Linked-cell particle container for efficient neighbor queries.
  *
  * This container organizes particles into a padded 3D grid (inner, boundary, halo cells)
- * to accelerate pairwise interactions. Particles are owned by the container; cells store
- * pointers into the owned storage.
+ * to accelerate pairwise interactions. Particles are owned by the container; the cell lists
+ * store pointers into the owned storage.
  *
  * \image html runtime_per_iter.jpeg
  * \image html runtime_wall_vs_particles.jpeg
@@ -13,15 +13,25 @@
  */
 
 #pragma once
+#include <algorithm>
 #include <array>
 #include <cstdint>
+#include <exception>
 #include <functional>
 #include <memory>
 #include <vector>
 
+#include "CellLists.h"
 #include "Container.h"
+#include "ParallelStrategy.h"
 #include "Particle.h"
 #include "spdlog/spdlog.h"
+#include "utils/HugePages.h"
+#include "utils/WorkStealingScheduler.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 enum class Face : uint8_t { XMin = 0, XMax = 1, YMin = 2, YMax = 3, ZMin = 4, ZMax = 5 };
 enum class BoundaryCondition : uint8_t { None, Outflow, Reflecting };
@@ -36,16 +46,17 @@ inline BoundaryCondition parseBoundaryCondition(const std::string &s) {
 enum class CellType : uint8_t { Inner, Boundary, Halo };
 
 struct LinkedCell {
-  CellType type;                      ///< Cell classification: Inner, Boundary, or Halo.
-  std::vector<Particle *> particles;  ///< Pointers to particles located in this cell.
+  CellType type;  ///< Cell classification: Inner, Boundary, or Halo.
 };
 
 /**
  * @class LinkedCellContainer
  * @brief Grid-based particle container implementing the linked-cell algorithm.
  *
- * Cells are laid out in a padded grid (+1 layer per face) to include halos. Each cell
- * holds pointers to particles owned by the container.
+ * Cells are laid out in a padded grid (+1 layer per face) to include halos. The particles of
+ * the cells are kept in CSR cell lists (one offset array, one contiguous pointer array) that
+ * are rebuilt by a counting sort: one for the owned particles in non-halo cells, one for the
+ * halo cells, so the ghosts can be placed while the interior cells are being traversed.
  */
 class LinkedCellContainer : public Container {
  public:
@@ -61,15 +72,88 @@ class LinkedCellContainer : public Container {
    * @param domain_size Physical domain extents (x,y,z). Origin is (0,0,0).
    */
   LinkedCellContainer(double r_cutoff, const std::array<double, 3> &domain_size);
+  /**
+   * @brief Construct a linked-cell grid for a box with an explicit origin (e.g. the sub-box of one MPI rank).
+   * @param r_cutoff Interaction cutoff; defines cell size.
+   * @param domain_min Lower corner of the box.
+   * @param domain_size Extents of the box (x,y,z).
+   */
+  LinkedCellContainer(double r_cutoff, const std::array<double, 3> &domain_min,
+                      const std::array<double, 3> &domain_size);
+  /// Origin used for a domain of the given size: (0,0,0), a single-cell z-extent is centered on z = 0.
+  static auto defaultDomainMin(const std::array<double, 3> &domain_size) -> std::array<double, 3>;
 
   /// Configure boundary condition handling applied during rebuild().
-  void setBoundaryConditions(const std::array<BoundaryCondition, 6> &conditions);
+  virtual void setBoundaryConditions(const std::array<BoundaryCondition, 6> &conditions);
   [[nodiscard]] auto getBoundaryConditions() const -> const std::array<BoundaryCondition, 6> &;
+  /**
+   * @brief Number of OpenMP threads used by the pair traversals (default 1, i.e. serial).
+   *
+   * With more than one thread the visitors of forEachPair and forEachCellPair are called concurrently, but never
+   * for two cells that share a particle, so visitors that only write the particles (cells) they are given are
+   * race-free. Without OpenMP the traversals stay serial.
+   */
+  void setNumThreads(int threads);
+  [[nodiscard]] auto getNumThreads() const noexcept -> int { return num_threads; }
+  /// How forEachPairForce accumulates forces when running on several threads (default Coloring).
+  void setParallelStrategy(ParallelStrategy strategy) { parallel_strategy = strategy; }
+  [[nodiscard]] auto getParallelStrategy() const noexcept -> ParallelStrategy { return parallel_strategy; }
+  /**
+   * @brief How the cells of a color are distributed over the threads (default Dynamic).
+   *
+   * WorkStealing rebalances every traversal: the cells are dealt out by their pair count n_i n_j (plus n_i for the
+   * force reset) and idle threads steal, which keeps threads busy when a few cells hold most particles.
+   */
+  void setCellSchedule(CellSchedule schedule) { cell_schedule = schedule; }
+  [[nodiscard]] auto getCellSchedule() const noexcept -> CellSchedule { return cell_schedule; }
+  /// Per-thread busy time of the work-stealing traversals.
+  [[nodiscard]] auto getScheduler() -> WorkStealingScheduler & { return scheduler; }
+  /// Which cell pairs a traversal task covers (default HalfShell); both visit the same pairs.
+  void setCellTraversal(CellTraversal traversal);
+  [[nodiscard]] auto getCellTraversal() const noexcept -> CellTraversal { return cell_traversal; }
+  /**
+   * @brief Software prefetch lookahead of the pair traversals in cell pairs (default 0 = off).
+   *
+   * While a cell pair of a task is processed, the particles of the pair this many pairs ahead are prefetched; near
+   * the end of the task that is the first cell of the next task. Helps when the particles are scattered in memory.
+   */
+  void setPrefetchDistance(int pairs) { prefetch_distance = pairs > 0 ? static_cast<std::size_t>(pairs) : 0; }
+  [[nodiscard]] auto getPrefetchDistance() const noexcept -> int { return static_cast<int>(prefetch_distance); }
 
   /// Rebuild the cell structure (clears particles and reinitializes metadata).
   void rebuild();
+  /**
+   * @brief Rebuild the cell structure, applying update to every owned particle right before it is binned.
+   *
+   * Lets integrators fuse their per-particle work (e.g. the position update) into the binning sweep. With several
+   * threads the sweep runs in parallel like forEachParticle, so update must only touch the particle it is given.
+   */
+  template <typename Func>
+  void rebuild(Func update);
+  /**
+   * @brief rebuild(update) followed by forEachPairForce(pair_force), overlapping the boundary work with the interior.
+   *
+   * With several threads, the Coloring strategy and the Dynamic schedule the owned particles are binned first. Then
+   * the tasks of all cells whose pairs involve no halo cell run color by color, while one concurrent task removes the
+   * outflowing particles and creates the ghosts of the reflecting faces; the tasks touching a halo cell run once the
+   * ghosts are placed.
+   * The pairs are the same as without overlap, only the order of the force sums differs. Forces are added to the
+   * current ones, so call resetForces() first unless update zeroes them. The WorkStealing schedule plans all cell
+   * tasks at once and therefore runs the rebuild and the traversal one after the other.
+   */
+  virtual void rebuildWithPairForces(const std::function<void(Particle &)> &update, const PairForce &pair_force);
   /// Clear all halo particles.
   void deleteHaloCells();
+  /**
+   * @brief Reallocate the owned particles in cell order, each on the thread that updates it in forEachParticle.
+   *
+   * Particles generated on one thread all live on the memory of its NUMA node. After this every thread of the static
+   * particle sweeps first-touches (and allocates from its own arena) the particles of its chunk, which with pinned
+   * threads puts them on its node. With a huge page mode the address range of every thread's particles is advised
+   * for transparent huge pages. Meant to be called once after the particles were generated; ghosts are dropped until
+   * the next rebuild.
+   */
+  void distributeStorage();
 
   /// Place a particle into the appropriate cell (inner/boundary/halo).
   auto addParticle(Particle &particle) -> Particle & override;
@@ -85,6 +169,13 @@ class LinkedCellContainer : public Container {
   auto reserve(std::size_t capacity) -> void override;
   /// Remove all particle references from all cells.
   auto clear() noexcept -> void override;
+  /**
+   * @brief Lazy force reset: starts a new force epoch in O(1).
+   *
+   * Every cell carries the epoch its forces were last zeroed in; the pair traversals zero a cell when they first
+   * touch it in a newer epoch. Forces read before the next traversal are therefore stale.
+   */
+  auto resetForces() -> void override { ++force_epoch; }
 
   /// Iteration over owned particles.
   auto begin() -> iterator override;
@@ -97,9 +188,74 @@ class LinkedCellContainer : public Container {
   /// Iterate over all unordered pairs.
   template <typename Func>
   void forEachPair(Func visitor);
+  /**
+   * @brief Iterate over all interacting cell pairs, one half-stencil or eighth-shell task per cell.
+   *
+   * The visitor receives the linear indices of both cells; the self pair of a cell is reported as (c, c).
+   * Both cells have their forces zeroed before the visit if a lazy force reset is pending.
+   *
+   * With several threads the cells are processed color by color. For the half-stencil cell (x, y, z) has color
+   * (x mod 2) + 2 (y mod 3) + 6 (z mod 3): the half-stencil of a cell spans 2 x 3 x 3 cells, so the stencils of
+   * two cells of the same color never overlap and a color can be processed in parallel without locks. The 2 x 2 x 2
+   * blocks of the eighth shell only need the parity (x mod 2) + 2 (y mod 2) + 4 (z mod 2).
+   * The cell pairs come from a cached list: the pairs of two occupied cells of every task, computed when the set of
+   * occupied cells changes and reused while it stays the same. Pairs with an empty cell are not reported, so sparse
+   * grids cost little more than their occupied cells.
+   * An exception thrown by the visitor is rethrown after the traversal.
+   */
+  template <typename Func>
+  void forEachCellPair(Func visitor);
+  /// Two interacting cells, a self pair if both are the same.
+  using CellPair = std::array<std::size_t, 2>;
+  /// The cached cell pairs of forEachCellPair, rebuilt only when the set of occupied cells changes.
+  [[nodiscard]] auto cellPairs() -> const std::vector<CellPair> & {
+    buildCellLists();
+    return cell_pairs;
+  }
+  /// Number of times the cached cell pairs have been rebuilt; unchanged while they are reused.
+  [[nodiscard]] auto cellPairsGeneration() -> std::size_t {
+    buildCellLists();
+    return pair_generation;
+  }
+  /// Number of cells in the padded grid (including halo cells).
+  [[nodiscard]] auto numCells() const noexcept -> std::size_t { return cells.size(); }
+  /// Particles currently located in the cell with the given linear index (valid until particles are added).
+  [[nodiscard]] auto cellParticles(std::size_t linear_index) -> CellLists::Range {
+    buildCellLists();
+    return cellRange(linear_index);
+  }
   auto forEachPair(const std::function<void(Particle &, Particle &)> &visitor) -> void override {
     forEachPair<const std::function<void(Particle &, Particle &)> &>(visitor);
   }
+  /**
+   * @brief Apply visitor to every owned particle.
+   *
+   * With several threads every thread processes one contiguous chunk of the particle storage.
+   */
+  template <typename Func>
+  void forEachParticle(Func visitor);
+  auto forEachParticle(const std::function<void(Particle &)> &visitor) -> void override {
+    forEachParticle<const std::function<void(Particle &)> &>(visitor);
+  }
+  /**
+   * @brief Apply a pair force to all unordered pairs, accumulated according to the parallel strategy.
+   *
+   * With one thread, or with Coloring, this is forEachPair with Newton's third law. ThreadBuffers, FullShell and
+   * Atomic traverse all cells in parallel without coloring; FullShell visits the full 27-cell neighborhood of every
+   * non-halo cell and leaves the forces of ghost particles at zero.
+   */
+  template <typename Func>
+  void forEachPairForce(Func pair_force);
+  auto forEachPairForce(const PairForce &pair_force) -> void override {
+    forEachPairForce<const PairForce &>(pair_force);
+  }
+  /**
+   * @brief Called after all pair forces of a force computation were added.
+   *
+   * forEachPairForce calls it itself; force calculations that traverse the cells on their own call it when they
+   * are done. A decomposed container returns the forces of imported ghosts to their owners here.
+   */
+  virtual void finishPairForces() {}
   /**
    * @brief Iterate over all boundary particles (inside domain, adjacent to halos).
    */
@@ -111,14 +267,166 @@ class LinkedCellContainer : public Container {
   template <typename Func>
   void forEachHaloParticle(Func visitor);
 
+ protected:
+  /// Remove particles that left the domain and create the ghosts of reflecting faces.
+  virtual void finishRebuild();
+  /// Remove the owned particles matching pred and return copies; the remaining particles are binned again.
+  template <typename Pred>
+  auto extractParticles(Pred pred) -> std::vector<Particle>;
+  /// Bin a ghost particle stored by a derived class (it must stay valid until the next rebuild).
+  void placeGhost(Particle &ghost) {
+    halo_lists.add(&ghost, haloCellIndexOf(ghost.getX()));
+    tasks_valid = false;
+  }
+  /// Ghosts of the reflecting faces created by the last rebuild.
+  [[nodiscard]] auto reflectedGhosts() -> LargeVector<Particle> & { return ghost_particles; }
+  [[nodiscard]] auto getDomainMin() const -> const std::array<double, 3> & { return domain_min; }
+  [[nodiscard]] auto getDomainSize() const -> const std::array<double, 3> & { return domain_size; }
+  [[nodiscard]] auto getCellDim() const -> const std::array<double, 3> & { return cell_dim; }
+  /**
+   * @brief Mark faces whose halo particles are owned and paired by a neighbor (eighth shell only).
+   *
+   * Eighth-shell tasks of the halo cells of these faces are skipped: their pairs are computed by the owner.
+   */
+  void setNeighborOwnedFaces(const std::array<bool, 6> &faces) {
+    if (faces == neighbor_owned_faces) return;
+    neighbor_owned_faces = faces;
+    pairs_stale = true;
+  }
+
  private:
   void initDimensions();
   void initCells();
+  /// Add an owned particle to the cell lists (halo cells go to the halo lists).
   void placeParticle(Particle *particle);
-  void createGhostsForFace(Face face);
+  /// Apply update to every owned particle and bin all of them anew (drops the ghosts); parallel with several threads.
+  template <typename Func>
+  void binOwnedParticles(Func &update);
+  /// Drop all particles from the cell lists.
+  void clearCellLists() {
+    owned_lists.clear();
+    halo_lists.clear();
+    tasks_valid = false;
+  }
+  /// Sort particles added since the last traversal into the cell lists and update the tasks.
+  void buildCellLists() {
+    owned_lists.build();
+    halo_lists.build();
+    if (!tasks_valid) updateTasks();
+  }
+  /// Rebuild the tasks, their cached cell pairs and their colors if the set of occupied cells changed.
+  void updateTasks();
+  /// Cache the occupied neighbors of every occupied cell (itself included, ascending) for FullShell.
+  void updateNeighbors();
+  /// Color of the task of a cell in the current traversal.
+  [[nodiscard]] auto colorOf(std::size_t linear) const -> std::size_t;
+  /// Particles of a cell; the cell lists have to be built.
+  [[nodiscard]] auto cellRange(std::size_t linear_index) const -> CellLists::Range {
+    return cells[linear_index].type == CellType::Halo ? halo_lists.cell(linear_index)
+                                                      : owned_lists.cell(linear_index);
+  }
+  /// Linear index of the cell containing the position.
+  [[nodiscard]] auto cellIndexOf(const std::array<double, 3> &pos) const -> std::size_t;
+  /// Like cellIndexOf, but a position on the surface of the box counts as outside (ghosts always go to a halo cell).
+  [[nodiscard]] auto haloCellIndexOf(const std::array<double, 3> &pos) const -> std::size_t;
+  /**
+   * @brief Visit the cell pairs of the task of one cell from the stencil, zeroing forces with a pending lazy reset.
+   *
+   * For traversals that cannot use the cached pairs because the occupied cells are not known yet.
+   * @param next Cell of the task that follows on this thread (prefetched at the end), no_cell if unknown
+   */
+  template <typename Func>
+  void visitCellPairs(std::size_t linear, Func &&visitor, std::size_t next = no_cell);
+  /**
+   * @brief Visit the cached cell pairs of a task (an index into active_cells), zeroing forces as visitCellPairs.
+   * @param next Task that follows on this thread (its cell is prefetched at the end), no_cell if unknown
+   */
+  template <typename Func>
+  void visitTaskPairs(std::size_t task, Func &&visitor, std::size_t next = no_cell) {
+    const auto begin = task_pair_start[task];
+    visitPairs(cell_pairs.data() + begin, task_pair_start[task + 1] - begin, visitor,
+               next == no_cell ? no_cell : active_cells[next]);
+  }
+  /// Visit count cell pairs with the lazy force reset and the prefetch lookahead; next is prefetched at the end.
+  template <typename Func>
+  void visitPairs(const CellPair *pairs, std::size_t count, Func &visitor, std::size_t next);
+  /// Prefetch the particle pointers and the particles of a cell.
+  void prefetchCell(std::size_t linear) const;
+  /// Call visitor(a, b) for the cell pairs of the task of one cell (self pair first) according to the traversal.
+  template <typename Func>
+  void forEachTaskPair(std::size_t linear, Func &&visitor) const;
+  /// Assign the cells to the colors of the current traversal and split every color into interior and halo tasks.
+  void buildColors();
+  /// forEachPairForce without finishPairForces(): serial, colored or one of the other parallel strategies.
+  template <typename Func>
+  void accumulatePairForces(Func &pair_force);
+  /// Call visitor(i, j) with the indices of all particle pairs of the cell pair (a, b); a == b visits i < j.
+  template <typename Func>
+  void visitParticlePairs(std::size_t a, std::size_t b, Func &visitor);
+  /// Estimated cost of a task: the sum of the costs of its pairs, which are stored in pair_costs.
+  auto taskCost(std::size_t task) -> double;
+  /// Zero the forces of all cells with a pending lazy reset, in parallel.
+  void touchAllCells();
+  /// Run body and keep the first exception it throws in error (exceptions must not leave an OpenMP region).
+  template <typename Body>
+  static void guarded(std::exception_ptr &error, Body body);
+#ifdef _OPENMP
+  template <typename Func>
+  void accumulateThreadBuffers(Func &pair_force);
+  template <typename Func>
+  void accumulateFullShell(Func &pair_force);
+  template <typename Func>
+  void accumulateAtomic(Func &pair_force);
+#endif
+  /// Zero the forces of a cell if this has not happened in the current force epoch yet.
+  void touchCell(std::size_t linear_index) {
+    if (cell_epoch[linear_index] != force_epoch) {
+      for (auto *p : cellRange(linear_index)) {
+        p->setF({0., 0., 0.});
+      }
+      cell_epoch[linear_index] = force_epoch;
+    }
+  }
+  /// Collect the particles of the boundary layer next to a face.
+  void collectBoundaryLayer(Face face, std::vector<Particle *> &layer);
+  /// Mirror the boundary layer of a face into ghost_particles[offset, offset + layer.size()), in parallel.
+  void createGhostsForFace(Face face, const std::vector<Particle *> &layer, std::size_t offset);
   [[nodiscard]] auto to3DIndex(std::size_t linear_index) const -> std::array<std::size_t, 3>;
   void logParticleCounts() const;
 
+  /// Half-stencil covering all 13 forward neighbors to avoid duplicate pair visits.
+  static constexpr std::array<std::array<int, 3>, 13> half_stencil{{{{1, 0, 0}},
+                                                                    {{1, 1, 0}},
+                                                                    {{1, -1, 0}},
+                                                                    {{0, 1, 0}},
+                                                                    {{1, 0, 1}},
+                                                                    {{1, 1, 1}},
+                                                                    {{1, -1, 1}},
+                                                                    {{0, 1, 1}},
+                                                                    {{1, 0, -1}},
+                                                                    {{1, 1, -1}},
+                                                                    {{1, -1, -1}},
+                                                                    {{0, 1, -1}},
+                                                                    {{0, 0, 1}}}};
+  /// Cell pairs of the 2 x 2 x 2 block that starts at a cell, besides the self pair of that cell.
+  static constexpr std::array<std::array<std::array<int, 3>, 2>, 13> eighth_shell{{{{{{0, 0, 0}}, {{1, 0, 0}}}},
+                                                                                   {{{{0, 0, 0}}, {{0, 1, 0}}}},
+                                                                                   {{{{0, 0, 0}}, {{0, 0, 1}}}},
+                                                                                   {{{{0, 0, 0}}, {{1, 1, 0}}}},
+                                                                                   {{{{0, 0, 0}}, {{1, 0, 1}}}},
+                                                                                   {{{{0, 0, 0}}, {{0, 1, 1}}}},
+                                                                                   {{{{0, 0, 0}}, {{1, 1, 1}}}},
+                                                                                   {{{{1, 0, 0}}, {{0, 1, 0}}}},
+                                                                                   {{{{1, 0, 0}}, {{0, 0, 1}}}},
+                                                                                   {{{{0, 1, 0}}, {{0, 0, 1}}}},
+                                                                                   {{{{1, 0, 0}}, {{0, 1, 1}}}},
+                                                                                   {{{{0, 1, 0}}, {{1, 0, 1}}}},
+                                                                                   {{{{0, 0, 1}}, {{1, 1, 0}}}}}};
+
+  static constexpr std::size_t no_cell = static_cast<std::size_t>(-1);
+  /// Cells per task of the overlapped rebuildWithPairForces.
+  static constexpr std::size_t overlap_task_cells = 16;
+
   static constexpr auto computeTotalCells(const std::array<std::size_t, 3> &dims) -> std::size_t {
     return dims[0] * dims[1] * dims[2];
   }
@@ -147,81 +455,458 @@ class LinkedCellContainer : public Container {
   }
 
   storage_type cells;
-  std::vector<std::unique_ptr<Particle>> owned_particles;  ///< Owned particle storage.
-  std::vector<std::unique_ptr<Particle>> ghost_particles;  ///< Ghost particle storage (not counted as owned).
+  LargeVector<std::uint64_t> cell_epoch;  ///< Force epoch in which each cell was last zeroed.
+  std::uint64_t force_epoch{0};            ///< Incremented by resetForces().
+  std::vector<std::vector<std::size_t>> color_cells;  ///< Linear cell indices of every color.
+  std::vector<std::vector<std::size_t>> interior_color_cells;  ///< Cells of every color whose task touches no halo.
+  std::vector<std::vector<std::size_t>> halo_color_cells;      ///< Cells of every color whose task touches a halo.
+  std::vector<std::size_t> occupied_cells;       ///< Occupied cells the cached pairs were built for, ascending.
+  std::vector<std::size_t> active_cells;         ///< Cell of every task with a pair of occupied cells, ascending.
+  std::vector<CellPair> cell_pairs;              ///< Cached pairs of all tasks, task after task, self pairs first.
+  std::vector<std::size_t> task_pair_start;      ///< Offsets of the tasks in cell_pairs (CSR).
+  std::size_t pair_generation{0};                ///< Incremented whenever updateTasks rebuilds cell_pairs.
+  std::vector<double> pair_costs;                ///< Estimated cost of every cached pair, set by the work-stealing plan.
+  std::vector<std::vector<std::size_t>> color_tasks;  ///< Tasks of every color.
+  std::vector<std::size_t> neighbor_start;       ///< Offsets of the occupied cells in cell_neighbors (CSR).
+  std::vector<std::size_t> cell_neighbors;       ///< Neighbors of the occupied cells, for FullShell.
+  std::vector<char> task_marks;                  ///< Scratch of updateTasks, all zero in between.
+  bool tasks_valid{false};                       ///< Cleared whenever the cell lists change.
+  bool pairs_stale{true};                        ///< Set when the pairs change without a change of occupancy.
+  bool neighbors_valid{false};                   ///< Cleared whenever the cached pairs are rebuilt.
+  int num_threads{1};
+  ParallelStrategy parallel_strategy{ParallelStrategy::Coloring};
+  CellSchedule cell_schedule{CellSchedule::Dynamic};
+  CellTraversal cell_traversal{CellTraversal::HalfShell};
+  std::array<bool, 6> neighbor_owned_faces{};  ///< Faces whose halo tasks are skipped by the eighth shell.
+  std::size_t prefetch_distance{0};            ///< Lookahead in cell pairs, 0 = no prefetching.
+  WorkStealingScheduler scheduler;
+  std::vector<LargeVector<double>> thread_forces;  ///< Per-thread force buffers of the ThreadBuffers strategy.
+  LargeVector<std::unique_ptr<Particle>> owned_particles;  ///< Owned particle storage.
+  LargeVector<Particle> ghost_particles;  ///< Contiguous ghost storage (not counted as owned), sized once per rebuild.
+  CellLists owned_lists;  ///< Owned particles of the non-halo cells.
+  CellLists halo_lists;   ///< Owned particles that left the box, then the ghosts.
+  LargeVector<std::size_t> particle_cells;  ///< Cell of every owned particle while binning.
   double r_cutoff;
   std::array<double, 3> cell_dim{};
   std::array<double, 3> domain_size{};
   std::array<double, 3> domain_min{};  ///< Optional shift of the domain origin (used for thin z-domains).
   std::array<std::size_t, 3> cells_per_dim{};
   std::array<std::size_t, 3> padded_dims{};
-  std::vector<LinkedCell *> boundary_cells;
-  std::vector<LinkedCell *> halo_cells;
+  std::vector<std::size_t> boundary_cells;  ///< Linear indices of the boundary cells.
+  std::vector<std::size_t> halo_cells;      ///< Linear indices of the halo cells.
   std::array<BoundaryCondition, 6> boundary_conditions{BoundaryCondition::Outflow, BoundaryCondition::Outflow,
                                                        BoundaryCondition::Outflow, BoundaryCondition::Outflow,
                                                        BoundaryCondition::Outflow, BoundaryCondition::Outflow};
 };
 
 template <typename Func>
-inline void LinkedCellContainer::forEachPair(Func visitor) {
-  // Half-stencil covering all 13 forward neighbors to avoid duplicate pair visits.
-  static constexpr std::array<std::array<int, 3>, 13> neighbor_offsets{{{{1, 0, 0}},
-                                                                        {{1, 1, 0}},
-                                                                        {{1, -1, 0}},
-                                                                        {{0, 1, 0}},
-                                                                        {{1, 0, 1}},
-                                                                        {{1, 1, 1}},
-                                                                        {{1, -1, 1}},
-                                                                        {{0, 1, 1}},
-                                                                        {{1, 0, -1}},
-                                                                        {{1, 1, -1}},
-                                                                        {{1, -1, -1}},
-                                                                        {{0, 1, -1}},
-                                                                        {{0, 0, 1}}}};
-
-  const auto cells_x = padded_dims.at(0);
-  const auto cells_y = padded_dims.at(1);
-  const auto cells_z = padded_dims.at(2);
-  const auto cells_xy = cells_x * cells_y;
-
-  for (std::size_t linear = 0; linear < cells.size(); ++linear) {
-    auto &current_particles = cells[linear].particles;
-
-    for (std::size_t i = 0; i < current_particles.size(); ++i) {
-      for (std::size_t j = i + 1; j < current_particles.size(); ++j) {
-        visitor(*current_particles[i], *current_particles[j]);
+inline void LinkedCellContainer::forEachTaskPair(std::size_t linear, Func &&visitor) const {
+  const int cells_x = static_cast<int>(padded_dims[0]);
+  const int cells_y = static_cast<int>(padded_dims[1]);
+  const int cells_z = static_cast<int>(padded_dims[2]);
+  const auto cells_xy = padded_dims[0] * padded_dims[1];
+  const int cx = static_cast<int>(linear % padded_dims[0]);
+  const int cy = static_cast<int>((linear / padded_dims[0]) % padded_dims[1]);
+  const int cz = static_cast<int>(linear / cells_xy);
+
+  auto cellAt = [&](const std::array<int, 3> &offset, std::size_t &index) {
+    const int nx = cx + offset[0];
+    const int ny = cy + offset[1];
+    const int nz = cz + offset[2];
+    if (nx < 0 || ny < 0 || nz < 0 || nx >= cells_x || ny >= cells_y || nz >= cells_z) return false;
+    index = toLinearIndex(static_cast<std::size_t>(nx), static_cast<std::size_t>(ny), static_cast<std::size_t>(nz),
+                          padded_dims);
+    return true;
+  };
+
+  if (cell_traversal == CellTraversal::HalfShell) {
+    visitor(linear, linear);
+    std::size_t neighbor = 0;
+    for (const auto &offset : half_stencil) {
+      if (cellAt(offset, neighbor)) visitor(linear, neighbor);
+    }
+    return;
+  }
+
+  const std::array<int, 3> coords{cx, cy, cz};
+  for (int d = 0; d < 3; ++d) {
+    const bool lower_halo = coords[d] == 0 && neighbor_owned_faces[2 * d];
+    const bool upper_halo = coords[d] == static_cast<int>(padded_dims[d]) - 1 && neighbor_owned_faces[2 * d + 1];
+    if (lower_halo || upper_halo) return;
+  }
+  visitor(linear, linear);
+  std::size_t a = 0;
+  std::size_t b = 0;
+  for (const auto &pair : eighth_shell) {
+    if (cellAt(pair[0], a) && cellAt(pair[1], b)) visitor(a, b);
+  }
+}
+
+template <typename Func>
+inline void LinkedCellContainer::visitCellPairs(std::size_t linear, Func &&visitor, std::size_t next) {
+  // pairs with an empty cell have nothing to compute and nothing to zero
+  std::array<CellPair, 1 + eighth_shell.size()> pairs{};
+  std::size_t count = 0;
+  forEachTaskPair(linear, [&](std::size_t a, std::size_t b) {
+    if (!cellRange(a).empty() && !cellRange(b).empty()) pairs[count++] = {a, b};
+  });
+  visitPairs(pairs.data(), count, visitor, next);
+}
+
+template <typename Func>
+inline void LinkedCellContainer::visitPairs(const CellPair *pairs, std::size_t count, Func &visitor, std::size_t next) {
+  if (prefetch_distance == 0) {
+    for (std::size_t i = 0; i < count; ++i) {
+      const auto [a, b] = pairs[i];
+      touchCell(a);
+      touchCell(b);
+      visitor(a, b);
+    }
+    return;
+  }
+
+  for (std::size_t i = 0; i < std::min(prefetch_distance, count); ++i) {
+    prefetchCell(pairs[i][1]);
+  }
+  for (std::size_t i = 0; i < count; ++i) {
+    const auto ahead = i + prefetch_distance;
+    if (ahead < count) {
+      prefetchCell(pairs[ahead][1]);
+    } else if (ahead == count && next != no_cell) {
+      prefetchCell(next);
+    }
+    const auto [a, b] = pairs[i];
+    touchCell(a);
+    touchCell(b);
+    visitor(a, b);
+  }
+}
+
+inline void LinkedCellContainer::prefetchCell(std::size_t linear) const {
+#if defined(__GNUC__) || defined(__clang__)
+  const auto particles = cellRange(linear);
+  __builtin_prefetch(particles.data());
+  for (const auto *p : particles) {
+    // a particle spans two cache lines: position and velocity, then force, mass and type
+    __builtin_prefetch(p);
+    __builtin_prefetch(reinterpret_cast<const char *>(p) + 64, 1);
+  }
+#else
+  (void)linear;
+#endif
+}
+
+template <typename Func>
+inline void LinkedCellContainer::forEachCellPair(Func visitor) {
+  buildCellLists();
+#ifdef _OPENMP
+  if (num_threads > 1 && cell_schedule == CellSchedule::WorkStealing) {
+    scheduler.plan(color_tasks, [this](std::size_t task) { return taskCost(task); }, num_threads);
+    std::exception_ptr error;
+    auto task = [&](std::size_t t) { guarded(error, [&] { visitTaskPairs(t, visitor); }); };
+#pragma omp parallel num_threads(num_threads)
+    for (std::size_t color = 0; color < color_tasks.size(); ++color) {
+      scheduler.run(color, omp_get_thread_num(), task);
+#pragma omp barrier
+    }
+    if (error) std::rethrow_exception(error);
+    return;
+  }
+  if (num_threads > 1) {
+    std::exception_ptr error;
+#pragma omp parallel num_threads(num_threads)
+    for (const auto &color : color_tasks) {
+      // the implicit barrier of the loop separates the colors
+#pragma omp for schedule(dynamic)
+      for (std::size_t i = 0; i < color.size(); ++i) {
+        // the next task of the color goes to any thread, so only the pairs of the task are prefetched
+        guarded(error, [&] { visitTaskPairs(color[i], visitor); });
       }
     }
+    if (error) std::rethrow_exception(error);
+    return;
+  }
+#endif
+
+  // serially the cached pairs are one sequence, the lookahead runs across the tasks
+  visitPairs(cell_pairs.data(), cell_pairs.size(), visitor, no_cell);
+}
+
+template <typename Func>
+inline void LinkedCellContainer::rebuild(Func update) {
+  ghost_particles.clear();  // drop ghosts from previous step
+  binOwnedParticles(update);
+  finishRebuild();
+}
+
+template <typename Func>
+inline void LinkedCellContainer::binOwnedParticles(Func &update) {
+  tasks_valid = false;
+  if (num_threads == 1) {
+    clearCellLists();
+    for (auto &p : owned_particles) {
+      update(*p);
+      placeParticle(p.get());
+    }
+    owned_lists.build();
+    return;
+  }
+
+  // the cells of all particles first, in parallel chunks; then one parallel counting sort per list
+  const auto n = owned_particles.size();
+  particle_cells.resize(n);
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static) if (num_threads > 1)
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    update(*owned_particles[i]);
+    particle_cells[i] = cellIndexOf(owned_particles[i]->getX());
+  }
+
+  auto particle = [this](std::size_t i) { return owned_particles[i].get(); };
+  auto is_halo = [this](std::size_t cell) { return cells[cell].type == CellType::Halo; };
+  auto not_halo = [this](std::size_t cell) { return cells[cell].type != CellType::Halo; };
+  owned_lists.assign(n, particle, particle_cells.data(), not_halo, num_threads);
+  halo_lists.assign(n, particle, particle_cells.data(), is_halo, num_threads);
+}
+
+template <typename Func>
+inline void LinkedCellContainer::visitParticlePairs(std::size_t a, std::size_t b, Func &visitor) {
+  const auto a_size = cellRange(a).size();
+  const auto b_size = cellRange(b).size();
+  for (std::size_t i = 0; i < a_size; ++i) {
+    for (std::size_t j = a == b ? i + 1 : 0; j < b_size; ++j) {
+      visitor(i, j);
+    }
+  }
+}
+
+template <typename Func>
+inline void LinkedCellContainer::forEachPair(Func visitor) {
+  forEachCellPair([&](std::size_t current, std::size_t neighbor) {
+    const auto current_particles = cellRange(current);
+    const auto neighbor_particles = cellRange(neighbor);
+    auto visit = [&](std::size_t i, std::size_t j) { visitor(*current_particles[i], *neighbor_particles[j]); };
+    visitParticlePairs(current, neighbor, visit);
+  });
+}
+
+template <typename Body>
+inline void LinkedCellContainer::guarded(std::exception_ptr &error, Body body) {
+  try {
+    body();
+  } catch (...) {
+#ifdef _OPENMP
+#pragma omp critical(linked_cell_traversal_error)
+#endif
+    if (!error) error = std::current_exception();
+  }
+}
+
+template <typename Func>
+inline void LinkedCellContainer::forEachPairForce(Func pair_force) {
+  accumulatePairForces(pair_force);
+  finishPairForces();
+}
+
+template <typename Func>
+inline void LinkedCellContainer::accumulatePairForces(Func &pair_force) {
+  buildCellLists();
+#ifdef _OPENMP
+  if (num_threads > 1) {
+    switch (parallel_strategy) {
+      case ParallelStrategy::Coloring:
+        break;
+      case ParallelStrategy::ThreadBuffers:
+        accumulateThreadBuffers(pair_force);
+        return;
+      case ParallelStrategy::FullShell:
+        accumulateFullShell(pair_force);
+        return;
+      case ParallelStrategy::Atomic:
+        accumulateAtomic(pair_force);
+        return;
+    }
+  }
+#endif
 
-    const int cx = static_cast<int>(linear % cells_x);
-    const int cy = static_cast<int>((linear / cells_x) % cells_y);
-    const int cz = static_cast<int>(linear / cells_xy);
+  forEachPair([&pair_force](Particle &p, Particle &q) {
+    const auto force = pair_force(p, q);
+    auto &fp = p.getF();
+    auto &fq = q.getF();
+    for (int d = 0; d < 3; ++d) {
+      fp[d] += force[d];
+      fq[d] -= force[d];
+    }
+  });
+}
+
+#ifdef _OPENMP
+template <typename Func>
+inline void LinkedCellContainer::accumulateThreadBuffers(Func &pair_force) {
+  touchAllCells();
+  // the buffers follow the cell lists: first the owned particles, then the halo particles
+  auto slot_of = [this](std::size_t c) {
+    return cells[c].type == CellType::Halo ? owned_lists.size() + halo_lists.start(c) : owned_lists.start(c);
+  };
+  const auto slots = 3 * (owned_lists.size() + halo_lists.size());
+
+  std::exception_ptr error;
+#pragma omp parallel num_threads(num_threads)
+  {
+    // the team may be smaller than requested, only its buffers are zeroed and reduced
+    const auto team = static_cast<std::size_t>(omp_get_num_threads());
+#pragma omp single
+    thread_forces.resize(team);
+    auto &buffer = thread_forces[static_cast<std::size_t>(omp_get_thread_num())];
+    buffer.assign(slots, 0.0);
+
+#pragma omp for schedule(dynamic)
+    for (std::size_t t = 0; t < active_cells.size(); ++t) {
+      guarded(error, [&] {
+        visitTaskPairs(t, [&](std::size_t a, std::size_t b) {
+          const auto a_particles = cellRange(a);
+          const auto b_particles = cellRange(b);
+          double *fa = buffer.data() + 3 * slot_of(a);
+          double *fb = buffer.data() + 3 * slot_of(b);
+          auto accumulate = [&](std::size_t i, std::size_t j) {
+            const auto force = pair_force(*a_particles[i], *b_particles[j]);
+            for (int d = 0; d < 3; ++d) {
+              fa[3 * i + d] += force[d];
+              fb[3 * j + d] -= force[d];
+            }
+          };
+          visitParticlePairs(a, b, accumulate);
+        });
+      });
+    }
+
+    // reduction over the threads, every thread owns a range of cells
+#pragma omp for schedule(static)
+    for (std::size_t i = 0; i < occupied_cells.size(); ++i) {
+      const auto c = occupied_cells[i];
+      const auto particles = cellRange(c);
+      for (std::size_t j = 0; j < particles.size(); ++j) {
+        const auto slot = 3 * (slot_of(c) + j);
+        auto &f = particles[j]->getF();
+        for (std::size_t t = 0; t < team; ++t) {
+          f[0] += thread_forces[t][slot];
+          f[1] += thread_forces[t][slot + 1];
+          f[2] += thread_forces[t][slot + 2];
+        }
+      }
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
 
-    for (const auto &offset : neighbor_offsets) {
-      const int nx = cx + offset[0];
-      const int ny = cy + offset[1];
-      const int nz = cz + offset[2];
+template <typename Func>
+inline void LinkedCellContainer::accumulateFullShell(Func &pair_force) {
+  touchAllCells();
+  if (!neighbors_valid) updateNeighbors();
 
-      if (nx < 0 || ny < 0 || nz < 0) continue;
-      if (nx >= static_cast<int>(cells_x) || ny >= static_cast<int>(cells_y) || nz >= static_cast<int>(cells_z))
-        continue;
+  std::exception_ptr error;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  for (std::size_t i = 0; i < occupied_cells.size(); ++i) {
+    const auto c = occupied_cells[i];
+    if (cells[c].type == CellType::Halo) continue;
+    guarded(error, [&] {
+      const auto *shell = cell_neighbors.data() + neighbor_start[i];
+      const auto shell_size = neighbor_start[i + 1] - neighbor_start[i];
 
-      const std::size_t neighbor_index = toLinearIndex(static_cast<std::size_t>(nx), static_cast<std::size_t>(ny),
-                                                       static_cast<std::size_t>(nz), padded_dims);
-      auto &neighbor_particles = cells[neighbor_index].particles;
-      for (auto *p : current_particles) {
-        for (auto *q : neighbor_particles) {
-          visitor(*p, *q);
+      // every pair is computed from both sides, so only the particles of this cell are written
+      for (auto *p : cellRange(c)) {
+        std::array<double, 3> sum{};
+        for (std::size_t n = 0; n < shell_size; ++n) {
+          for (const auto *q : cellRange(shell[n])) {
+            if (q == p) continue;
+            const auto force = pair_force(*p, *q);
+            sum[0] += force[0];
+            sum[1] += force[1];
+            sum[2] += force[2];
+          }
         }
+        auto &f = p->getF();
+        f[0] += sum[0];
+        f[1] += sum[1];
+        f[2] += sum[2];
       }
+    });
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+template <typename Func>
+inline void LinkedCellContainer::accumulateAtomic(Func &pair_force) {
+  touchAllCells();
+
+  std::exception_ptr error;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic)
+  for (std::size_t t = 0; t < active_cells.size(); ++t) {
+    guarded(error, [&] {
+      visitTaskPairs(t, [&](std::size_t a, std::size_t b) {
+        const auto a_particles = cellRange(a);
+        const auto b_particles = cellRange(b);
+        for (std::size_t i = 0; i < a_particles.size(); ++i) {
+          // the row of particle i is summed locally, its partners are updated atomically
+          std::array<double, 3> sum{};
+          for (std::size_t j = a == b ? i + 1 : 0; j < b_particles.size(); ++j) {
+            const auto force = pair_force(*a_particles[i], *b_particles[j]);
+            auto &fq = b_particles[j]->getF();
+            for (int d = 0; d < 3; ++d) {
+              sum[d] += force[d];
+#pragma omp atomic
+              fq[d] -= force[d];
+            }
+          }
+          auto &fp = a_particles[i]->getF();
+          for (int d = 0; d < 3; ++d) {
+#pragma omp atomic
+            fp[d] += sum[d];
+          }
+        }
+      });
+    });
+  }
+  if (error) std::rethrow_exception(error);
+}
+#endif
+
+template <typename Pred>
+inline auto LinkedCellContainer::extractParticles(Pred pred) -> std::vector<Particle> {
+  std::vector<Particle> extracted;
+  std::size_t kept = 0;
+  for (auto &p : owned_particles) {
+    if (pred(*p)) {
+      extracted.push_back(*p);
+    } else {
+      owned_particles[kept++] = std::move(p);
     }
   }
+  owned_particles.resize(kept);
+  if (!extracted.empty()) {
+    auto keep = [](Particle &) {};
+    binOwnedParticles(keep);
+  }
+  return extracted;
+}
+
+template <typename Func>
+inline void LinkedCellContainer::forEachParticle(Func visitor) {
+  const auto n = owned_particles.size();
+#ifdef _OPENMP
+#pragma omp parallel for num_threads(num_threads) schedule(static) if (num_threads > 1)
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    visitor(*owned_particles[i]);
+  }
 }
 
 template <typename Func>
 inline void LinkedCellContainer::forEachBoundaryParticle(Func visitor) {
-  for (auto *cell : boundary_cells) {
-    for (auto &p : cell->particles) {
+  buildCellLists();
+  for (const auto linear : boundary_cells) {
+    for (auto *p : cellRange(linear)) {
       visitor(p);
     }
   }
@@ -229,8 +914,9 @@ inline void LinkedCellContainer::forEachBoundaryParticle(Func visitor) {
 
 template <typename Func>
 inline void LinkedCellContainer::forEachHaloParticle(Func visitor) {
-  for (auto *cell : halo_cells) {
-    for (auto &p : cell->particles) {
+  buildCellLists();
+  for (const auto linear : halo_cells) {
+    for (auto *p : cellRange(linear)) {
       visitor(p);
     }
   }
@@ -0,0 +1,89 @@
+/**
+ * @file ParallelStrategy.h
+ */
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+/**
+ * Class to differentiate between the ways the linked-cell container accumulates pair forces on several threads
+ *
+ * Coloring processes cells of one color at a time with Newton's third law, ThreadBuffers gives every thread its own
+ * force array that is reduced afterwards, FullShell computes every pair twice so a thread only writes the particles
+ * of its own cell, and Atomic adds the forces with atomic updates.
+ */
+enum class ParallelStrategy { Coloring, ThreadBuffers, FullShell, Atomic };
+
+inline auto parseParallelStrategy(const std::string &strategy) -> ParallelStrategy {
+  if (strategy == "Coloring" || strategy == "coloring") {
+    return ParallelStrategy::Coloring;
+  }
+  if (strategy == "ThreadBuffers" || strategy == "threadBuffers" || strategy == "buffers") {
+    return ParallelStrategy::ThreadBuffers;
+  }
+  if (strategy == "FullShell" || strategy == "fullShell") {
+    return ParallelStrategy::FullShell;
+  }
+  if (strategy == "Atomic" || strategy == "atomic") {
+    return ParallelStrategy::Atomic;
+  }
+  SPDLOG_ERROR("Invalid parallel strategy: {}", strategy);
+  return ParallelStrategy::Coloring;
+}
+
+inline auto parallelStrategyName(ParallelStrategy strategy) -> const char * {
+  switch (strategy) {
+    case ParallelStrategy::Coloring:
+      return "Coloring";
+    case ParallelStrategy::ThreadBuffers:
+      return "ThreadBuffers";
+    case ParallelStrategy::FullShell:
+      return "FullShell";
+    case ParallelStrategy::Atomic:
+      return "Atomic";
+  }
+  return "Coloring";
+}
+
+/**
+ * Class to differentiate between the ways the cells of one color are distributed over the threads
+ *
+ * Dynamic hands out cells in index order to whichever thread is free, WorkStealing deals the cells out by their
+ * estimated cost n_i n_j and lets idle threads steal.
+ */
+enum class CellSchedule { Dynamic, WorkStealing };
+
+inline auto parseCellSchedule(const std::string &schedule) -> CellSchedule {
+  if (schedule == "Dynamic" || schedule == "dynamic") {
+    return CellSchedule::Dynamic;
+  }
+  if (schedule == "WorkStealing" || schedule == "workStealing") {
+    return CellSchedule::WorkStealing;
+  }
+  SPDLOG_ERROR("Invalid cell schedule: {}", schedule);
+  return CellSchedule::Dynamic;
+}
+
+/**
+ * Class to differentiate between the cell pairs a linked-cell traversal task covers
+ *
+ * HalfShell pairs every cell with the 13 forward neighbors of its 3 x 3 x 3 neighborhood. EighthShell covers the 2 x
+ * 2 x 2 block that starts at the cell: the 13 cell pairs inside the block whose lowest corner is the task cell
+ * (Bowers' eighth-shell / midpoint assignment). Both visit every neighboring cell pair exactly once, but an eighth-
+ * shell task only reaches forward, so a sub-box only needs the halo of its three upper faces, and blocks of the same
+ * parity never overlap (8 colors instead of 18).
+ */
+enum class CellTraversal { HalfShell, EighthShell };
+
+inline auto parseCellTraversal(const std::string &traversal) -> CellTraversal {
+  if (traversal == "HalfShell" || traversal == "halfShell") {
+    return CellTraversal::HalfShell;
+  }
+  if (traversal == "EighthShell" || traversal == "eighthShell") {
+    return CellTraversal::EighthShell;
+  }
+  SPDLOG_ERROR("Invalid cell traversal: {}", traversal);
+  return CellTraversal::HalfShell;
+}
@@ -12,7 +12,6 @@
 Particle::Particle(int type_arg) : x(), v(), m(0) {
   type = type_arg;
   f = {0., 0., 0.};
-  old_f = {0., 0., 0.};
 
   // debug-level: particle creation (compiled out by default when LOG_LEVEL=INFO)
   SPDLOG_TRACE("Particle generated (type={})", type);
@@ -22,7 +21,6 @@ Particle::Particle(const Particle &other) {
   x = other.x;
   v = other.v;
   f = other.f;
-  old_f = other.old_f;
   m = other.m;
   type = other.type;
 
@@ -31,7 +29,7 @@ Particle::Particle(const Particle &other) {
 }
 
 Particle::Particle(const std::array<double, 3> &x_arg, const std::array<double, 3> &v_arg, const double m_arg, int type)
-    : x(x_arg), v(v_arg), f({0., 0., 0.}), old_f({0., 0., 0.}), m(m_arg), type(type) {
+    : x(x_arg), v(v_arg), f({0., 0., 0.}), m(m_arg), type(type) {
   SPDLOG_DEBUG("Particle generated at position ({}, {}, {})", x[0], x[1], x[2]);
 }
 
@@ -56,31 +54,25 @@ void Particle::setV(const std::array<double, 3> &newV) { v = newV; }
 
 const std::array<double, 3> &Particle::getF() const { return f; }
 
+std::array<double, 3> &Particle::getF() { return f; }
+
 /**
  * @param newF New force vector
  */
 void Particle::setF(const std::array<double, 3> &newF) { f = newF; }
 
-const std::array<double, 3> &Particle::getOldF() const { return old_f; }
-
-/**
- * @param oldF Old force vector
- */
-void Particle::setOldF(const std::array<double, 3> &oldF) { old_f = oldF; }
-
 double Particle::getM() const { return m; }
 
 int Particle::getType() const { return type; }
 
 std::string Particle::toString() const {
   std::stringstream stream;
-  stream << "Particle: X:" << x << " v: " << v << " f: " << f << " old_f: " << old_f << " type: " << type;
+  stream << "Particle: X:" << x << " v: " << v << " f: " << f << " type: " << type;
   return stream.str();
 }
 
 bool Particle::operator==(const Particle &other) const {
-  return (x == other.x) and (v == other.v) and (f == other.f) and (type == other.type) and (m == other.m) and
-         (old_f == other.old_f);
+  return (x == other.x) and (v == other.v) and (f == other.f) and (type == other.type) and (m == other.m);
 }
 
 std::ostream &operator<<(std::ostream &stream, const Particle &p) {
@@ -28,11 +28,6 @@ class Particle {
    */
   std::array<double, 3> f{};
 
-  /**
-   * @brief Force which was effective on this particle
-   */
-  std::array<double, 3> old_f{};
-
   /**
    * @brief Mass of this particle
    */
@@ -100,22 +95,15 @@ class Particle {
    * @return Reference to the force array
    */
   const std::array<double, 3> &getF() const;
-
   /**
-   * @brief Set the current force acting on the particle
+   * @brief Mutable access to the force, for in-place (e.g. atomic) accumulation
    */
-  void setF(const std::array<double, 3> &);
+  std::array<double, 3> &getF();
 
   /**
-   * @brief Get the old force that was acting on the particle
-   * @return Reference to the old force array
-   */
-  const std::array<double, 3> &getOldF() const;
-
-  /**
-   * @brief Set the old force that was acting on the particle
+   * @brief Set the current force acting on the particle
    */
-  void setOldF(const std::array<double, 3> &);
+  void setF(const std::array<double, 3> &);
 
   /**
    * @brief Get the mass of the particle
@@ -17,6 +17,7 @@
 
 #include "Container.h"
 #include "Particle.h"
+#include "utils/HugePages.h"
 
 /**
  * @class ParticleContainer
@@ -34,7 +35,7 @@
 class ParticleContainer : public Container {
  public:
   /// Type alias for the underlying storage container.
-  using storage_type = std::vector<Particle>;
+  using storage_type = LargeVector<Particle>;
   using iterator = Container::iterator;
   using const_iterator = Container::const_iterator;
 
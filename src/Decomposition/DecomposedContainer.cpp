@@ -0,0 +1,201 @@
+#include "DecomposedContainer.h"
+
+#include <spdlog/spdlog.h>
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+/// x, v, f, m and type of a particle.
+constexpr std::size_t values_per_particle = 11;
+
+void pack(const Particle &p, std::vector<double> &buffer) {
+  const auto &x = p.getX();
+  const auto &v = p.getV();
+  const auto &f = p.getF();
+  buffer.insert(buffer.end(), {x[0], x[1], x[2], v[0], v[1], v[2], f[0], f[1], f[2], p.getM(),
+                               static_cast<double>(p.getType())});
+}
+
+Particle unpack(const double *values) {
+  Particle p({values[0], values[1], values[2]}, {values[3], values[4], values[5]}, values[9],
+             static_cast<int>(values[10]));
+  p.setF({values[6], values[7], values[8]});
+  return p;
+}
+}  // namespace
+
+DecomposedContainer::DecomposedContainer(double r_cutoff, const DomainDecomposition &decomposition,
+                                         std::unique_ptr<Transport> transport)
+    : LinkedCellContainer(r_cutoff, decomposition.getLocalMin(), decomposition.getLocalSize()),
+      decomposition(decomposition),
+      transport(std::move(transport)) {
+  setBoundaryConditions(getBoundaryConditions());
+  const auto &dims = decomposition.getDims();
+  const auto &coords = decomposition.getCoords();
+  SPDLOG_INFO("Rank {} of {} owns sub-box ({}, {}, {}) of a {}x{}x{} grid.", decomposition.getRank(),
+              this->transport->size(), coords[0], coords[1], coords[2], dims[0], dims[1], dims[2]);
+}
+
+auto DecomposedContainer::addParticle(Particle &particle) -> Particle & {
+  if (!decomposition.owns(particle.getX())) {
+    discarded = particle;
+    return discarded;
+  }
+  return LinkedCellContainer::addParticle(particle);
+}
+
+auto DecomposedContainer::emplaceParticle(const std::array<double, 3> &pos, const std::array<double, 3> &vel,
+                                          double mass, int type) -> Particle & {
+  if (!decomposition.owns(pos)) {
+    discarded = Particle(pos, vel, mass, type);
+    return discarded;
+  }
+  return LinkedCellContainer::emplaceParticle(pos, vel, mass, type);
+}
+
+void DecomposedContainer::setBoundaryConditions(const std::array<BoundaryCondition, 6> &conditions) {
+  auto masked = conditions;
+  for (std::size_t face = 0; face < masked.size(); ++face) {
+    if (decomposition.neighbor(static_cast<Face>(face)) >= 0) {
+      masked[face] = BoundaryCondition::None;
+    }
+  }
+  LinkedCellContainer::setBoundaryConditions(masked);
+}
+
+auto DecomposedContainer::globalSize() -> std::size_t {
+  return static_cast<std::size_t>(transport->allReduceSum(static_cast<double>(size())));
+}
+
+void DecomposedContainer::finishRebuild() {
+  remote_ghosts.clear();
+  migrate();
+  LinkedCellContainer::finishRebuild();
+  exchangeHalo();
+}
+
+void DecomposedContainer::rebuildWithPairForces(const std::function<void(Particle &)> &update,
+                                                const PairForce &pair_force) {
+  rebuild(update);
+  forEachPairForce(pair_force);
+}
+
+void DecomposedContainer::migrate() {
+  const auto &lo = getDomainMin();
+  const auto &extent = getDomainSize();
+  std::vector<double> to_lower, to_upper, received;
+
+  for (int axis = 0; axis < 3; ++axis) {
+    const int lower = decomposition.neighbor(static_cast<Face>(2 * axis));
+    const int upper = decomposition.neighbor(static_cast<Face>(2 * axis + 1));
+    const double hi = lo[axis] + extent[axis];
+
+    to_lower.clear();
+    to_upper.clear();
+    const auto leaving = extractParticles([&](const Particle &p) {
+      const double x = p.getX()[axis];
+      return (lower >= 0 && x < lo[axis]) || (upper >= 0 && x >= hi);
+    });
+    for (const auto &p : leaving) {
+      pack(p, p.getX()[axis] < lo[axis] ? to_lower : to_upper);
+    }
+
+    // shift down, then up; arrivals are binned right away and may move on along the next axis
+    for (const bool down : {true, false}) {
+      transport->sendRecv(down ? to_lower : to_upper, down ? lower : upper, received, down ? upper : lower);
+      for (std::size_t i = 0; i < received.size(); i += values_per_particle) {
+        auto p = unpack(received.data() + i);
+        LinkedCellContainer::addParticle(p);
+      }
+    }
+  }
+}
+
+auto DecomposedContainer::computesPairsOnce() const -> bool {
+  const bool full_shell = getNumThreads() > 1 && getParallelStrategy() == ParallelStrategy::FullShell;
+  return getCellTraversal() == CellTraversal::EighthShell && !full_shell;
+}
+
+void DecomposedContainer::exchangeHalo() {
+  const auto &layer = getCellDim();
+  const auto &lo = getDomainMin();
+  const auto &extent = getDomainSize();
+  std::vector<double> to_lower, to_upper, received;
+
+  // eighth-shell blocks only reach forward: import the upper halos and leave their pairs to the owners
+  returns_forces = computesPairsOnce();
+  std::array<bool, 6> neighbor_owned{};
+  for (int axis = 0; axis < 3; ++axis) {
+    neighbor_owned[2 * axis + 1] = returns_forces && decomposition.neighbor(static_cast<Face>(2 * axis + 1)) >= 0;
+  }
+  setNeighborOwnedFaces(neighbor_owned);
+
+  for (int axis = 0; axis < 3; ++axis) {
+    const int lower = decomposition.neighbor(static_cast<Face>(2 * axis));
+    const int upper = decomposition.neighbor(static_cast<Face>(2 * axis + 1));
+    const double hi = lo[axis] + extent[axis];
+
+    to_lower.clear();
+    to_upper.clear();
+    sent_ghosts[axis].clear();
+    auto select = [&](Particle &p) {
+      const double x = p.getX()[axis];
+      if (lower >= 0 && x >= lo[axis] && x < lo[axis] + layer[axis]) {
+        pack(p, to_lower);
+        sent_ghosts[axis].push_back(&p);
+      }
+      if (!returns_forces && upper >= 0 && x < hi && x >= hi - layer[axis]) pack(p, to_upper);
+    };
+    for (auto &p : *this) {
+      select(p);
+    }
+    for (auto &ghost : reflectedGhosts()) {
+      select(ghost);
+    }
+    for (auto &ghost : remote_ghosts) {
+      select(ghost);
+    }
+
+    received_begin[axis] = remote_ghosts.size();
+    for (const bool down : {true, false}) {
+      if (!down && returns_forces) break;
+      transport->sendRecv(down ? to_lower : to_upper, down ? lower : upper, received, down ? upper : lower);
+      for (std::size_t i = 0; i < received.size(); i += values_per_particle) {
+        remote_ghosts.push_back(unpack(received.data() + i));
+        remote_ghosts.back().setF({0., 0., 0.});
+        placeGhost(remote_ghosts.back());
+      }
+    }
+  }
+  received_begin[3] = remote_ghosts.size();
+}
+
+void DecomposedContainer::finishPairForces() {
+  if (!returns_forces) return;
+  std::vector<double> forces, received;
+
+  // backwards through the axes, so forces on forwarded ghosts travel on to their owners
+  for (int axis = 2; axis >= 0; --axis) {
+    const int lower = decomposition.neighbor(static_cast<Face>(2 * axis));
+    const int upper = decomposition.neighbor(static_cast<Face>(2 * axis + 1));
+
+    forces.clear();
+    for (auto i = received_begin[axis]; i < received_begin[axis + 1]; ++i) {
+      const auto &f = remote_ghosts[i].getF();
+      forces.insert(forces.end(), f.begin(), f.end());
+    }
+    transport->sendRecv(forces, upper, received, lower);
+
+    auto &sent = sent_ghosts[axis];
+    if (received.size() != 3 * sent.size()) {
+      throw std::runtime_error("Returned ghost forces do not match the halo sent along axis " + std::to_string(axis));
+    }
+    for (std::size_t i = 0; i < sent.size(); ++i) {
+      auto &f = sent[i]->getF();
+      f[0] += received[3 * i];
+      f[1] += received[3 * i + 1];
+      f[2] += received[3 * i + 2];
+    }
+  }
+}
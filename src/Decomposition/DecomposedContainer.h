@@ -0,0 +1,81 @@
+/**
+ * @file DecomposedContainer.h
+ * @brief Linked-cell container for the sub-box of one rank of a domain decomposition.
+ */
+#pragma once
+
+#include <array>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "Container/LinkedCellContainer.h"
+#include "DomainDecomposition.h"
+#include "Transport.h"
+
+/**
+ * @brief The sub-box of one rank as a LinkedCellContainer that talks to the neighboring ranks.
+ *
+ * Only particles inside the sub-box are stored; particles emplaced elsewhere belong to other ranks and are dropped.
+ * Every rebuild (plain or fused) ends with two exchanges along x, then y, then z:
+ *  - migration: owned particles that left the sub-box through a face with a neighbor are sent to that neighbor,
+ *  - halo exchange: copies of all particles (owned and ghosts) in the cell layer at a face are sent to the neighbor
+ *    and become ghosts in its halo cells. Forwarding the ghosts received along earlier axes covers edges and
+ *    corners.
+ * Pairs with ghosts are then computed on both ranks, so no forces have to be sent back. With the eighth-shell
+ * traversal every pair is computed once instead: a sub-box only imports the halo of its upper faces, and
+ * finishPairForces() sends the forces on these ghosts back to their owners (FullShell on several threads still
+ * needs the full halo). Boundary conditions only apply at the faces of the global box; the faces between sub-boxes
+ * behave like "None".
+ *
+ * A particle may cross at most one sub-box per step, which the cell size (>= r_cutoff) guarantees for every stable
+ * time step. All ranks must rebuild in lockstep.
+ */
+class DecomposedContainer : public LinkedCellContainer {
+ public:
+  /**
+   * @param r_cutoff Interaction cutoff; defines cell size.
+   * @param decomposition Geometry of the decomposition and position of this rank
+   * @param transport Messages to the other ranks
+   */
+  DecomposedContainer(double r_cutoff, const DomainDecomposition &decomposition, std::unique_ptr<Transport> transport);
+
+  using LinkedCellContainer::emplaceParticle;
+  /// Store the particle if it lies in the sub-box of this rank.
+  auto addParticle(Particle &particle) -> Particle & override;
+  /// Store the particle if it lies in the sub-box of this rank; otherwise the returned particle is a discarded copy.
+  auto emplaceParticle(const std::array<double, 3> &pos, const std::array<double, 3> &vel, double mass, int type)
+      -> Particle & override;
+  /// Apply the boundary conditions at the faces of the global box, the inner faces stay "None".
+  void setBoundaryConditions(const std::array<BoundaryCondition, 6> &conditions) override;
+
+  [[nodiscard]] auto getDecomposition() const -> const DomainDecomposition & { return decomposition; }
+  [[nodiscard]] auto getTransport() -> Transport & { return *transport; }
+  /// Number of particles on all ranks (collective).
+  [[nodiscard]] auto globalSize() -> std::size_t;
+  /// Ghosts received from other ranks in the last rebuild.
+  [[nodiscard]] auto importedGhosts() const -> std::size_t { return remote_ghosts.size(); }
+  /// Return the forces on imported ghosts to their owners (eighth shell, collective).
+  void finishPairForces() override;
+  /// No overlap: migration rebins all cells, so this is rebuild(update) followed by forEachPairForce(pair_force).
+  void rebuildWithPairForces(const std::function<void(Particle &)> &update, const PairForce &pair_force) override;
+
+ protected:
+  void finishRebuild() override;
+
+ private:
+  /// Send the owned particles that left the sub-box to the neighbors.
+  void migrate();
+  /// Receive copies of the neighbors' boundary layers as ghosts.
+  void exchangeHalo();
+  /// Whether the pair traversal computes every pair once, so the halo is one-sided and forces are returned.
+  [[nodiscard]] auto computesPairsOnce() const -> bool;
+
+  DomainDecomposition decomposition;
+  std::unique_ptr<Transport> transport;
+  std::deque<Particle> remote_ghosts;  ///< Ghosts received from other ranks, stable addresses for the cells.
+  bool returns_forces = false;         ///< The last halo exchange was one-sided.
+  std::array<std::vector<Particle *>, 3> sent_ghosts;  ///< Particles sent to the lower neighbor per axis.
+  std::array<std::size_t, 4> received_begin{};       ///< remote_ghosts[received_begin[a], received_begin[a + 1]).
+  Particle discarded;                  ///< Returned for particles emplaced outside the sub-box.
+};
@@ -0,0 +1,78 @@
+#include "DomainDecomposition.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+DomainDecomposition::DomainDecomposition(int rank, const std::array<int, 3> &dims,
+                                         const std::array<double, 3> &global_min,
+                                         const std::array<double, 3> &global_size)
+    : rank(rank), dims(dims), global_min(global_min), global_size(global_size) {
+  if (rank < 0 || rank >= dims[0] * dims[1] * dims[2]) {
+    throw std::invalid_argument("Rank " + std::to_string(rank) + " is outside of the rank grid");
+  }
+  coords = {rank % dims[0], (rank / dims[0]) % dims[1], rank / (dims[0] * dims[1])};
+  for (int d = 0; d < 3; ++d) {
+    local_size[d] = global_size[d] / dims[d];
+    local_min[d] = global_min[d] + coords[d] * local_size[d];
+  }
+}
+
+auto DomainDecomposition::createDims(int ranks, const std::array<int, 3> &requested,
+                                     const std::array<double, 3> &global_size, double r_cutoff)
+    -> std::array<int, 3> {
+  std::array<int, 3> max_dims{};
+  for (int d = 0; d < 3; ++d) {
+    max_dims[d] = std::max(1, static_cast<int>(std::floor(global_size[d] / r_cutoff)));
+  }
+
+  std::array<int, 3> best{};
+  double best_surface = std::numeric_limits<double>::infinity();
+  for (int x = 1; x <= ranks; ++x) {
+    for (int y = 1; x * y <= ranks; ++y) {
+      if (ranks % (x * y) != 0) continue;
+      const std::array<int, 3> candidate{x, y, ranks / (x * y)};
+
+      bool valid = true;
+      for (int d = 0; d < 3; ++d) {
+        valid = valid && (requested[d] <= 0 || requested[d] == candidate[d]) && candidate[d] <= max_dims[d];
+      }
+      if (!valid) continue;
+
+      const double sx = global_size[0] / x, sy = global_size[1] / y, sz = global_size[2] / candidate[2];
+      const double surface = sx * sy + sy * sz + sx * sz;
+      if (surface < best_surface) {
+        best_surface = surface;
+        best = candidate;
+      }
+    }
+  }
+
+  if (best_surface == std::numeric_limits<double>::infinity()) {
+    throw std::invalid_argument("No rank grid with " + std::to_string(ranks) +
+                                " ranks matches the requested dimensions and the domain size");
+  }
+  return best;
+}
+
+auto DomainDecomposition::neighbor(Face face) const -> int {
+  const auto axis = static_cast<int>(face) / 2;
+  const bool upper = static_cast<int>(face) % 2 == 1;
+  auto c = coords;
+  c[axis] += upper ? 1 : -1;
+  if (c[axis] < 0 || c[axis] >= dims[axis]) {
+    return -1;
+  }
+  return c[0] + dims[0] * (c[1] + dims[1] * c[2]);
+}
+
+auto DomainDecomposition::owns(const std::array<double, 3> &position) const -> bool {
+  for (int d = 0; d < 3; ++d) {
+    const double shifted = position[d] - global_min[d];
+    const int cell = std::min(dims[d] - 1, std::max(0, static_cast<int>(std::floor(shifted / local_size[d]))));
+    if (cell != coords[d]) return false;
+  }
+  return true;
+}
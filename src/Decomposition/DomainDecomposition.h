@@ -0,0 +1,57 @@
+/**
+ * @file DomainDecomposition.h
+ * @brief Cartesian decomposition of the simulation box into one sub-box per rank.
+ */
+#pragma once
+
+#include <array>
+
+#include "Container/LinkedCellContainer.h"
+
+/**
+ * @brief Geometry of a Cartesian domain decomposition.
+ *
+ * The global box is split into dims[0] x dims[1] x dims[2] equally sized sub-boxes. Rank r has the grid coordinates
+ * (r mod dims[0], (r / dims[0]) mod dims[1], r / (dims[0] dims[1])). A position belongs to the sub-box [lo, hi) in
+ * every dimension, the last sub-box of a dimension also contains its upper face.
+ */
+class DomainDecomposition {
+ public:
+  /**
+   * @param rank Rank of this process
+   * @param dims Number of sub-boxes per dimension
+   * @param global_min Lower corner of the global box
+   * @param global_size Extents of the global box
+   */
+  DomainDecomposition(int rank, const std::array<int, 3> &dims, const std::array<double, 3> &global_min,
+                      const std::array<double, 3> &global_size);
+
+  /**
+   * @brief Complete a requested rank grid.
+   *
+   * Entries > 0 are kept, the entries <= 0 are chosen so that the product equals ranks and the sub-boxes have the
+   * smallest surface (halo volume). No dimension gets more sub-boxes than it has cells of width r_cutoff.
+   * Throws std::invalid_argument if no such grid exists.
+   */
+  static auto createDims(int ranks, const std::array<int, 3> &requested, const std::array<double, 3> &global_size,
+                         double r_cutoff) -> std::array<int, 3>;
+
+  [[nodiscard]] auto getRank() const -> int { return rank; }
+  [[nodiscard]] auto getDims() const -> const std::array<int, 3> & { return dims; }
+  [[nodiscard]] auto getCoords() const -> const std::array<int, 3> & { return coords; }
+  [[nodiscard]] auto getLocalMin() const -> const std::array<double, 3> & { return local_min; }
+  [[nodiscard]] auto getLocalSize() const -> const std::array<double, 3> & { return local_size; }
+  /// Rank of the neighboring sub-box across a face, -1 at the faces of the global box.
+  [[nodiscard]] auto neighbor(Face face) const -> int;
+  /// Whether the position lies in the sub-box of this rank (positions outside the global box are clamped).
+  [[nodiscard]] auto owns(const std::array<double, 3> &position) const -> bool;
+
+ private:
+  int rank;
+  std::array<int, 3> dims;
+  std::array<int, 3> coords{};
+  std::array<double, 3> global_min;
+  std::array<double, 3> global_size;
+  std::array<double, 3> local_min{};
+  std::array<double, 3> local_size{};
+};
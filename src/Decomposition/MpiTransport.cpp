@@ -0,0 +1,40 @@
+#include "MpiTransport.h"
+
+#ifdef MOLSIM_ENABLE_MPI
+
+namespace {
+constexpr int count_tag = 0;
+constexpr int data_tag = 1;
+
+int peer(int rank) { return rank < 0 ? MPI_PROC_NULL : rank; }
+}  // namespace
+
+MpiEnvironment::MpiEnvironment(int &argc, char **&argv) { MPI_Init(&argc, &argv); }
+
+MpiEnvironment::~MpiEnvironment() { MPI_Finalize(); }
+
+MpiTransport::MpiTransport(MPI_Comm comm) : comm_(comm) {
+  MPI_Comm_rank(comm_, &rank_);
+  MPI_Comm_size(comm_, &size_);
+}
+
+void MpiTransport::sendRecv(const std::vector<double> &send, int dest, std::vector<double> &recv, int source) {
+  unsigned long send_count = send.size();
+  unsigned long recv_count = 0;
+  MPI_Sendrecv(&send_count, 1, MPI_UNSIGNED_LONG, peer(dest), count_tag, &recv_count, 1, MPI_UNSIGNED_LONG,
+               peer(source), count_tag, comm_, MPI_STATUS_IGNORE);
+
+  recv.resize(source < 0 ? 0 : recv_count);
+  MPI_Sendrecv(send.data(), static_cast<int>(send_count), MPI_DOUBLE, peer(dest), data_tag, recv.data(),
+               static_cast<int>(recv.size()), MPI_DOUBLE, peer(source), data_tag, comm_, MPI_STATUS_IGNORE);
+}
+
+double MpiTransport::allReduceSum(double value) {
+  double sum = 0.0;
+  MPI_Allreduce(&value, &sum, 1, MPI_DOUBLE, MPI_SUM, comm_);
+  return sum;
+}
+
+void MpiTransport::barrier() { MPI_Barrier(comm_); }
+
+#endif
@@ -0,0 +1,45 @@
+/**
+ * @file MpiTransport.h
+ * @brief Transport over an MPI communicator (only built with -DENABLE_MPI=ON).
+ */
+#pragma once
+
+#ifdef MOLSIM_ENABLE_MPI
+
+#include <mpi.h>
+
+#include "Transport.h"
+
+/**
+ * @brief Initializes MPI for the lifetime of the object (create it once at the start of main).
+ */
+class MpiEnvironment {
+ public:
+  MpiEnvironment(int &argc, char **&argv);
+  ~MpiEnvironment();
+  MpiEnvironment(const MpiEnvironment &) = delete;
+  MpiEnvironment &operator=(const MpiEnvironment &) = delete;
+};
+
+/**
+ * @brief Transport between the processes of an MPI communicator.
+ *
+ * Buffers are exchanged with two MPI_Sendrecv calls, the first one transfers the lengths.
+ */
+class MpiTransport : public Transport {
+ public:
+  explicit MpiTransport(MPI_Comm comm = MPI_COMM_WORLD);
+
+  [[nodiscard]] int rank() const override { return rank_; }
+  [[nodiscard]] int size() const override { return size_; }
+  void sendRecv(const std::vector<double> &send, int dest, std::vector<double> &recv, int source) override;
+  [[nodiscard]] double allReduceSum(double value) override;
+  void barrier() override;
+
+ private:
+  MPI_Comm comm_;
+  int rank_ = 0;
+  int size_ = 1;
+};
+
+#endif
@@ -0,0 +1,53 @@
+#include "SharedMemoryDecomposition.h"
+
+#include <spdlog/spdlog.h>
+
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Container/ContainerFactory.h"
+#include "SharedMemoryTransport.h"
+#include "Simulation/SimulationFactory.h"
+#include "utils/Affinity.h"
+
+namespace SharedMemoryDecomposition {
+void runSimulation(const SimulationConfig &cfg) {
+  const int threads = cfg.subdomains;
+  SPDLOG_INFO("Shared-memory domain decomposition on {} threads.", threads);
+
+  // every sub-box thread is pinned before it allocates, so its particles are first touched on its own NUMA node
+  const auto cpus = parallel::pinningOrder(cfg.pinning, parallel::availableCpus());
+
+  auto hub = std::make_shared<SharedMemoryHub>(threads);
+  std::vector<std::exception_ptr> errors(static_cast<std::size_t>(threads));
+  std::vector<std::thread> workers;
+  workers.reserve(static_cast<std::size_t>(threads));
+
+  for (int rank = 0; rank < threads; ++rank) {
+    workers.emplace_back([&, rank] {
+      try {
+        if (!cpus.empty()) parallel::pinCurrentThread(cpus[static_cast<std::size_t>(rank) % cpus.size()]);
+        // everything of the sub-box is created on its own thread
+        auto container =
+            ContainerFactory::createDecomposedContainer(cfg, std::make_unique<SharedMemoryTransport>(hub, rank));
+        auto simulation = SimulationFactory::createSimulation(cfg, *container);
+        simulation->runSimulation();
+      } catch (const SharedMemoryHub::Aborted &) {
+        // another thread failed first, its exception is rethrown below
+      } catch (...) {
+        errors[static_cast<std::size_t>(rank)] = std::current_exception();
+        // the other threads would wait for this one at their next exchange forever
+        hub->abort();
+      }
+    });
+  }
+  for (auto &worker : workers) {
+    worker.join();
+  }
+  for (const auto &error : errors) {
+    if (error) std::rethrow_exception(error);
+  }
+}
+}  // namespace SharedMemoryDecomposition
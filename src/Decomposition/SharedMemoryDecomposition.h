@@ -0,0 +1,26 @@
+/**
+ * @file SharedMemoryDecomposition.h
+ * @brief Runs a molecule simulation as a domain decomposition over the threads of one process.
+ */
+#pragma once
+
+#include "inputReader/SimulationConfig.h"
+
+/**
+ * @brief Threaded alternative to the colored traversal: every thread owns one sub-box.
+ *
+ * Each of cfg.subdomains threads builds its own DecomposedContainer and runs the whole simulation on it, exactly
+ * like an MPI rank would, but the halo layers and migrating particles are exchanged through SharedMemoryTransport.
+ * Cells and particles of a sub-box are allocated by the thread that works on them (first touch), and the pair
+ * loops run without any synchronization; the threads only meet in the exchanges of the rebuild.
+ */
+namespace SharedMemoryDecomposition {
+/**
+ * @brief Run the simulation of cfg on cfg.subdomains threads and wait for all of them.
+ *
+ * An exception of a thread aborts the hub, so the other threads leave their next exchange instead of waiting for
+ * it, and is rethrown after all threads finished.
+ * @param cfg Simulation configuration with a linked-cell container
+ */
+void runSimulation(const SimulationConfig &cfg);
+}  // namespace SharedMemoryDecomposition
@@ -0,0 +1,54 @@
+#include "SharedMemoryTransport.h"
+
+#include <utility>
+
+SharedMemoryHub::SharedMemoryHub(int ranks)
+    : ranks(ranks), mailboxes(static_cast<std::size_t>(ranks * ranks)), slots(static_cast<std::size_t>(ranks)) {}
+
+void SharedMemoryHub::arriveAndWait() {
+  std::unique_lock<std::mutex> guard(lock);
+  if (aborted) throw Aborted();
+  const auto arrived_in = generation;
+  if (++waiting == ranks) {
+    waiting = 0;
+    ++generation;
+    released.notify_all();
+    return;
+  }
+  released.wait(guard, [&] { return generation != arrived_in || aborted; });
+  if (generation == arrived_in) throw Aborted();
+}
+
+void SharedMemoryHub::abort() {
+  const std::lock_guard<std::mutex> guard(lock);
+  aborted = true;
+  released.notify_all();
+}
+
+SharedMemoryTransport::SharedMemoryTransport(std::shared_ptr<SharedMemoryHub> hub, int rank)
+    : hub(std::move(hub)), rank_(rank) {}
+
+void SharedMemoryTransport::sendRecv(const std::vector<double> &send, int dest, std::vector<double> &recv,
+                                     int source) {
+  if (dest >= 0) {
+    hub->mailbox(dest, rank_) = send;
+  }
+  hub->arriveAndWait();
+  recv.clear();
+  if (source >= 0) {
+    std::swap(recv, hub->mailbox(rank_, source));
+  }
+  // nobody may refill a mailbox before its receiver took it
+  hub->arriveAndWait();
+}
+
+double SharedMemoryTransport::allReduceSum(double value) {
+  hub->slot(rank_) = value;
+  hub->arriveAndWait();
+  double sum = 0.0;
+  for (int r = 0; r < hub->size(); ++r) {
+    sum += hub->slot(r);
+  }
+  hub->arriveAndWait();
+  return sum;
+}
@@ -0,0 +1,72 @@
+/**
+ * @file SharedMemoryTransport.h
+ * @brief Transport between the threads of one process, each thread acting as one rank.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+#include "Transport.h"
+
+/**
+ * @brief State shared by the threads of a shared-memory decomposition: one mailbox per (receiver, sender) pair and
+ * a reusable barrier.
+ */
+class SharedMemoryHub {
+ public:
+  /// Thrown by arriveAndWait() in the remaining threads once a thread aborted the hub.
+  class Aborted : public std::runtime_error {
+   public:
+    Aborted() : std::runtime_error("Another thread of the shared-memory decomposition failed") {}
+  };
+
+  explicit SharedMemoryHub(int ranks);
+
+  [[nodiscard]] int size() const { return ranks; }
+  /// Block until all ranks arrived; throws Aborted if the hub was or gets aborted.
+  void arriveAndWait();
+  /// Release all waiting threads with Aborted, for a thread that will never arrive again (e.g. after an exception).
+  void abort();
+  [[nodiscard]] auto mailbox(int receiver, int sender) -> std::vector<double> & {
+    return mailboxes[static_cast<std::size_t>(receiver * ranks + sender)];
+  }
+  [[nodiscard]] auto slot(int rank) -> double & { return slots[static_cast<std::size_t>(rank)]; }
+
+ private:
+  int ranks;
+  std::vector<std::vector<double>> mailboxes;
+  std::vector<double> slots;  ///< One value per rank for the reductions.
+
+  std::mutex lock;
+  std::condition_variable released;
+  int waiting = 0;
+  std::size_t generation = 0;
+  bool aborted = false;
+};
+
+/**
+ * @brief Transport of one thread of a shared-memory decomposition.
+ *
+ * sendRecv() leaves the buffer in the mailbox of the receiver and takes the one of the sender after a barrier, so
+ * particle data is copied once and never serialized into messages. Every operation is collective over all threads
+ * of the hub.
+ */
+class SharedMemoryTransport : public Transport {
+ public:
+  SharedMemoryTransport(std::shared_ptr<SharedMemoryHub> hub, int rank);
+
+  [[nodiscard]] int rank() const override { return rank_; }
+  [[nodiscard]] int size() const override { return hub->size(); }
+  void sendRecv(const std::vector<double> &send, int dest, std::vector<double> &recv, int source) override;
+  [[nodiscard]] double allReduceSum(double value) override;
+  void barrier() override { hub->arriveAndWait(); }
+
+ private:
+  std::shared_ptr<SharedMemoryHub> hub;
+  int rank_;
+};
@@ -0,0 +1,47 @@
+/**
+ * @file Transport.h
+ * @brief Abstract message transport between the ranks of a domain decomposition.
+ */
+#pragma once
+
+#include <vector>
+
+/**
+ * @brief Point-to-point and collective operations the domain decomposition needs, independent of MPI.
+ *
+ * Ranks are numbered 0 .. size() - 1. A rank of -1 stands for "no neighbor": nothing is sent to it and nothing is
+ * received from it. Every operation must be called by all ranks in the same order.
+ */
+class Transport {
+ public:
+  virtual ~Transport() = default;
+
+  [[nodiscard]] virtual int rank() const = 0;
+  [[nodiscard]] virtual int size() const = 0;
+  /**
+   * @brief Send a buffer to dest and receive one of arbitrary length from source at the same time.
+   * @param send Values sent to dest
+   * @param dest Receiving rank or -1
+   * @param recv Resized to the values received from source (empty for -1)
+   * @param source Sending rank or -1
+   */
+  virtual void sendRecv(const std::vector<double> &send, int dest, std::vector<double> &recv, int source) = 0;
+  /// Sum of value over all ranks.
+  [[nodiscard]] virtual double allReduceSum(double value) = 0;
+  virtual void barrier() = 0;
+};
+
+/**
+ * @brief Transport of a run with a single rank.
+ */
+class SingleRankTransport : public Transport {
+ public:
+  [[nodiscard]] int rank() const override { return 0; }
+  [[nodiscard]] int size() const override { return 1; }
+  void sendRecv(const std::vector<double> & /*send*/, int /*dest*/, std::vector<double> &recv,
+                int /*source*/) override {
+    recv.clear();
+  }
+  [[nodiscard]] double allReduceSum(double value) override { return value; }
+  void barrier() override {}
+};
@@ -16,43 +16,80 @@ class ForceCalculation {
   // default destructor
   virtual ~ForceCalculation() = default;
   /**
-   * @brief Function for calculating the force for each particle, implemented by each sub-class
+   * @brief Function for calculating the force for each particle: resets the forces, then adds the pair forces
    * @param particles Particle container on which the calculations are performed
    */
-  virtual void calculateF(Container &particles) = 0;
+  void calculateF(Container &particles) {
+    resetForces(particles);
+    addForces(particles);
+  }
+  /**
+   * @brief Function for adding the pair forces to the current forces, implemented by each sub-class
+   *
+   * Separated from the reset so that integrators can fuse the reset into their own particle sweeps.
+   * @param particles Particle container on which the calculations are performed
+   */
+  virtual void addForces(Container &particles) = 0;
+  /**
+   * @brief The force on the first particle of a pair, if addForces only adds such pair forces
+   *
+   * Empty for calculations that traverse the particles on their own. Lets the linked-cell step compute the pair
+   * forces of the interior cells while the ghosts are still being created.
+   */
+  [[nodiscard]] virtual auto pairForceFunction() const -> Container::PairForce { return {}; }
+  /**
+   * @brief Function for setting the forces of all particles to zero
+   *
+   * The linked-cell container only marks the forces as stale and zeroes each cell when the pair traversal first
+   * touches it, so the reset needs no separate sweep.
+   * @param particles Particle container on which the calculations are performed
+   */
+  static void resetForces(Container &particles) { particles.resetForces(); }
   /**
-   * @brief Function for calculating the position updates of the particles
+   * @brief Function for the first half of a kick-drift-kick (velocity Verlet) step
+   *
+   * Runs through Container::forEachParticle, i.e. in parallel chunks on a multi-threaded linked-cell container.
+   *
+   * Opening half kick with the current forces, then the drift with the new velocities. Together with calculateF and
+   * calculateV this gives the same trajectory as x += dt v + dt^2 / 2m F(t), v += dt / 2m (F(t) + F(t + dt)), but only
+   * the current force has to be stored.
    * @param particles Particle container on which the calculations are performed
    * @param delta_t Time step
    */
   static void calculateX(Container &particles, double delta_t) {
-    // calculate the position updates using the methods in the ArrayUtils class
     // since the formulas are the same regardless of simulation, the method is included in the base class
-    for (auto &p : particles) {
-      p.setX(ArrayUtils::elementWisePairOp(
-          p.getX(),
-          ArrayUtils::elementWisePairOp(
-              ArrayUtils::elementWiseScalarOp(delta_t, p.getV(), std::multiplies<>()),
-              ArrayUtils::elementWiseScalarOp(pow(delta_t, 2) / (2 * p.getM()), p.getF(), std::multiplies<>()),
-              std::plus<>()),
-          std::plus<>()));
-    }
+    particles.forEachParticle([delta_t](Particle &p) {
+      kick(p, delta_t);
+      drift(p, delta_t);
+    });
   }
   /**
-   * @brief Function for calculating the velocities of the particles
+   * @brief Function for the closing half kick of a kick-drift-kick step with the new forces
    * @param particles Particle container on which the calculations are performed
    * @param delta_t Time step
    */
   static void calculateV(Container &particles, double delta_t) {
-    // calculate the forces using the methods in the ArrayUtils class
-    // since the formulas are the same regardless of simulation, the method is included in the base class
-    for (auto &p : particles) {
-      p.setV(ArrayUtils::elementWisePairOp(
-          p.getV(),
-          ArrayUtils::elementWiseScalarOp(delta_t / (2 * p.getM()),
-                                          ArrayUtils::elementWisePairOp(p.getOldF(), p.getF(), std::plus<>()),
-                                          std::multiplies<>()),
-          std::plus<>()));
-    }
+    particles.forEachParticle([delta_t](Particle &p) { kick(p, delta_t); });
+  }
+  /**
+   * @brief Half kick of a single particle: v += dt / 2m * F
+   * @param p Particle to accelerate
+   * @param delta_t Time step
+   */
+  static void kick(Particle &p, double delta_t) {
+    const double scale = delta_t / (2 * p.getM());
+    const auto &v = p.getV();
+    const auto &f = p.getF();
+    p.setV({v[0] + scale * f[0], v[1] + scale * f[1], v[2] + scale * f[2]});
+  }
+  /**
+   * @brief Drift of a single particle: x += dt * v
+   * @param p Particle to move
+   * @param delta_t Time step
+   */
+  static void drift(Particle &p, double delta_t) {
+    const auto &x = p.getX();
+    const auto &v = p.getV();
+    p.setX({x[0] + delta_t * v[0], x[1] + delta_t * v[1], x[2] + delta_t * v[2]});
   }
-};
\ No newline at end of file
+};
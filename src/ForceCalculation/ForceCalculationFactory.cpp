@@ -0,0 +1,68 @@
+#include "ForceCalculationFactory.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "LennardJones.h"
+#include "TabulatedPotential.h"
+#include "TruncatedShiftedLennardJones.h"
+#include "VectorizedLennardJones.h"
+
+namespace {
+/**
+ * @brief Lennard-Jones parameters of every type id up to the largest one used in the configuration
+ *
+ * Types listed in particleTypes get their own parameters, all others use simulation.epsilon and simulation.sigma.
+ */
+std::vector<TruncatedShiftedLennardJones::TypeParameters> typeParameters(const SimulationConfig &cfg) {
+  int max_type = 0;
+  for (const auto &c : cfg.cuboids) max_type = std::max(max_type, c.type);
+  for (const auto &d : cfg.discs) max_type = std::max(max_type, d.typeDisc);
+  for (const auto &t : cfg.particleTypes) max_type = std::max(max_type, t.type);
+
+  std::vector<TruncatedShiftedLennardJones::TypeParameters> types(static_cast<std::size_t>(max_type) + 1,
+                                                                  {cfg.epsilon, cfg.sigma});
+  for (const auto &t : cfg.particleTypes) {
+    types[static_cast<std::size_t>(t.type)] = {t.epsilon, t.sigma};
+  }
+  return types;
+}
+}  // namespace
+
+std::unique_ptr<ForceCalculation> ForceCalculationFactory::createForceCalculation(const SimulationConfig &cfg) {
+  // the other forces have a single parameter set and would silently use simulation.epsilon and simulation.sigma
+  if (!cfg.particleTypes.empty() && cfg.forceType != ForceType::TruncatedShiftedLennardJones) {
+    throw std::invalid_argument("Config error: particleTypes is only supported by force TruncatedShiftedLennardJones");
+  }
+  switch (cfg.forceType) {
+    case ForceType::LennardJones: {
+      auto lj = std::make_unique<LennardJones>();
+      lj->setEpsilon(cfg.epsilon);
+      lj->setSigma(cfg.sigma);
+      return lj;
+    }
+    case ForceType::VectorizedLennardJones:
+      return std::make_unique<VectorizedLennardJones>(cfg.epsilon, cfg.sigma, cfg.rCutoff);
+    case ForceType::Tabulated: {
+      const auto &t = cfg.tabulated;
+      const auto points = static_cast<std::size_t>(t.points);
+      switch (t.potential) {
+        case TabulatedPotentialType::Morse:
+          return std::make_unique<TabulatedPotential>(
+              TabulatedPotential::morse(t.morseDepth, t.morseWidth, t.morseR0, t.rMin, cfg.rCutoff, points));
+        case TabulatedPotentialType::SoftSphere:
+          return std::make_unique<TabulatedPotential>(TabulatedPotential::softSphere(
+              cfg.epsilon, cfg.sigma, t.softSphereExponent, t.rMin, cfg.rCutoff, points));
+        case TabulatedPotentialType::File:
+          return std::make_unique<TabulatedPotential>(TabulatedPotential::fromFile(t.file, cfg.rCutoff, points));
+        case TabulatedPotentialType::LennardJones:
+        default:
+          return std::make_unique<TabulatedPotential>(
+              TabulatedPotential::lennardJones(cfg.epsilon, cfg.sigma, t.rMin, cfg.rCutoff, points));
+      }
+    }
+    case ForceType::TruncatedShiftedLennardJones:
+    default:
+      return std::make_unique<TruncatedShiftedLennardJones>(typeParameters(cfg), cfg.rCutoff);
+  }
+}
@@ -0,0 +1,20 @@
+/**
+ * @file ForceCalculationFactory.h
+ * @brief Factory for creating the force calculation of molecule simulations
+ */
+#pragma once
+
+#include <memory>
+
+#include "../inputReader/SimulationConfig.h"
+#include "ForceCalculation.h"
+
+namespace ForceCalculationFactory {
+/**
+ * @brief creates the force calculation selected in the configuration
+ * @param cfg Simulation configuration containing the force type and its parameters
+ * @return a new force calculation of the specified type
+ * @throws std::invalid_argument if particleTypes are given for a force other than TruncatedShiftedLennardJones
+ */
+std::unique_ptr<ForceCalculation> createForceCalculation(const SimulationConfig &cfg);
+}  // namespace ForceCalculationFactory
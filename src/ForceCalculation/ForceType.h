@@ -0,0 +1,52 @@
+/**
+ * @file ForceType.h
+ */
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+/**
+ * Class to differentiate between the different force calculations of molecule simulations
+ */
+enum class ForceType { LennardJones, TruncatedShiftedLennardJones, VectorizedLennardJones, Tabulated };
+
+inline auto parseForceType(const std::string &force) -> ForceType {
+  if (force == "LennardJones" || force == "lennardJones" || force == "lj") {
+    return ForceType::LennardJones;
+  }
+  if (force == "TruncatedShiftedLennardJones" || force == "truncatedShiftedLennardJones" || force == "ljts") {
+    return ForceType::TruncatedShiftedLennardJones;
+  }
+  if (force == "VectorizedLennardJones" || force == "vectorizedLennardJones" || force == "simd") {
+    return ForceType::VectorizedLennardJones;
+  }
+  if (force == "Tabulated" || force == "tabulated") {
+    return ForceType::Tabulated;
+  }
+  SPDLOG_ERROR("Invalid force type: {}", force);
+  return ForceType::TruncatedShiftedLennardJones;
+}
+
+/**
+ * Class to differentiate between the pair potentials a tabulated force can be built from
+ */
+enum class TabulatedPotentialType { LennardJones, Morse, SoftSphere, File };
+
+inline auto parseTabulatedPotentialType(const std::string &potential) -> TabulatedPotentialType {
+  if (potential == "LennardJones" || potential == "lennardJones" || potential == "lj") {
+    return TabulatedPotentialType::LennardJones;
+  }
+  if (potential == "Morse" || potential == "morse") {
+    return TabulatedPotentialType::Morse;
+  }
+  if (potential == "SoftSphere" || potential == "softSphere") {
+    return TabulatedPotentialType::SoftSphere;
+  }
+  if (potential == "File" || potential == "file") {
+    return TabulatedPotentialType::File;
+  }
+  SPDLOG_ERROR("Invalid tabulated potential: {}", potential);
+  return TabulatedPotentialType::LennardJones;
+}
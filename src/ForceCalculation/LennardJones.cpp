@@ -14,23 +14,24 @@ double LennardJones::calculateU(const Particle &p1, const Particle &p2) const {
   const double sr6 = std::pow(sr, 6);
   return 4.0 * epsilon * (sr6 * sr6 - sr6);
 }
-void LennardJones::calculateF(Container &particles) {
-  for (auto &p : particles) {
-    // initialize to 0 so the simulation runs as expected
-    p.setOldF(p.getF());
-    p.setF({0., 0., 0.});
-  }
+void LennardJones::addForces(Container &particles) {
   // Use pair iterator to calculates forces between each pair of particles
-  particles.forEachPair([this](Particle &p1, Particle &p2) { calc(p1, p2, epsilon, sigma); });
+  particles.forEachPairForce(pairForceFunction());
 }
-void LennardJones::calc(Particle &p1, Particle &p2, double epsilon, double sigma) {
+auto LennardJones::pairForceFunction() const -> Container::PairForce {
+  return [this](const Particle &p1, const Particle &p2) { return pairForce(p1, p2, epsilon, sigma); };
+}
+std::array<double, 3> LennardJones::pairForce(const Particle &p1, const Particle &p2, double epsilon, double sigma) {
   const auto diff = ArrayUtils::elementWisePairOp(p1.getX(), p2.getX(), std::minus<>());
   const double distance = std::max(ArrayUtils::L2Norm(diff), 1e-12);
   const double invR2 = 1.0 / (distance * distance);
   const double sr = sigma / distance;
   const double sr6 = std::pow(sr, 6);
   const double scalar = 24.0 * epsilon * invR2 * sr6 * (2.0 * sr6 - 1.0);
-  std::array<double, 3> newF = ArrayUtils::elementWiseScalarOp(scalar, diff, std::multiplies<>());
+  return ArrayUtils::elementWiseScalarOp(scalar, diff, std::multiplies<>());
+}
+void LennardJones::calc(Particle &p1, Particle &p2, double epsilon, double sigma) {
+  const std::array<double, 3> newF = pairForce(p1, p2, epsilon, sigma);
   // Set the new values making use of Newton's third law
   p1.setF(ArrayUtils::elementWisePairOp(p1.getF(), newF, std::plus<>()));
   p2.setF(ArrayUtils::elementWisePairOp(p2.getF(), newF, std::minus<>()));
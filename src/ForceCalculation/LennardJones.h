@@ -22,10 +22,11 @@ class LennardJones : public ForceCalculation {
   void setSigma(double sig) { this->sigma = sig; }
   [[nodiscard]] double calculateU(const Particle &p1, const Particle &p2) const;
   /**
-   * @brief Calculates the forces using the Lennard-Jones formulas
+   * @brief Adds the forces using the Lennard-Jones formulas
    * @param particles Particle container on which the calculations are performed
    */
-  void calculateF(Container &particles) override;
+  void addForces(Container &particles) override;
+  [[nodiscard]] auto pairForceFunction() const -> Container::PairForce override;
   /**
    * @brief Calculate the force between two particles using Lennard-Jones formula
    * @param p1 First particle
@@ -34,4 +35,12 @@ class LennardJones : public ForceCalculation {
    * @param sigma
    */
   static void calc(Particle &p1, Particle &p2, double epsilon, double sigma);
+  /**
+   * @brief Lennard-Jones force on p1 from p2
+   * @param p1 First particle
+   * @param p2 Second particle
+   * @param epsilon
+   * @param sigma
+   */
+  static std::array<double, 3> pairForce(const Particle &p1, const Particle &p2, double epsilon, double sigma);
 };
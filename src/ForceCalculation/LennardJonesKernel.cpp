@@ -0,0 +1,272 @@
+/**
+ * @file LennardJonesKernel.cpp
+ * @brief Scalar, SSE4, AVX2 and AVX-512 Lennard-Jones kernels.
+ *
+ * The SIMD variants are compiled with per-function target attributes, so the binary runs on every x86-64
+ * CPU and only calls the variants the CPU supports.
+ */
+#include "LennardJonesKernel.h"
+
+#include <initializer_list>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define MOLSIM_X86_DISPATCH 1
+#include <immintrin.h>
+#endif
+
+namespace LennardJonesKernel {
+
+namespace {
+
+/// Pair force for the entries [begin, block.n); shared by the scalar kernel and the SIMD remainder loops.
+inline void scalarRange(double xi, double yi, double zi, const Block &block, const Parameters &params, double *fi,
+                        std::size_t begin) {
+  double fxi = 0.0;
+  double fyi = 0.0;
+  double fzi = 0.0;
+  for (std::size_t j = begin; j < block.n; ++j) {
+    const double dx = xi - block.x[j];
+    const double dy = yi - block.y[j];
+    const double dz = zi - block.z[j];
+    const double r2 = dx * dx + dy * dy + dz * dz;
+    const double inv_r2 = 1.0 / r2;
+    const double sr2 = params.sigma2 * inv_r2;
+    const double sr6 = sr2 * sr2 * sr2;
+    const bool inside = r2 < params.cutoff2 && r2 > 0.0;
+    const double scalar = inside ? params.epsilon24 * inv_r2 * sr6 * (2.0 * sr6 - 1.0) : 0.0;
+    fxi += scalar * dx;
+    fyi += scalar * dy;
+    fzi += scalar * dz;
+    block.fx[j] -= scalar * dx;
+    block.fy[j] -= scalar * dy;
+    block.fz[j] -= scalar * dz;
+  }
+  fi[0] += fxi;
+  fi[1] += fyi;
+  fi[2] += fzi;
+}
+
+void kernelScalar(double xi, double yi, double zi, const Block &block, const Parameters &params, double *fi) {
+  scalarRange(xi, yi, zi, block, params, fi, 0);
+}
+
+#ifdef MOLSIM_X86_DISPATCH
+
+__attribute__((target("sse4.1"))) void kernelSse4(double xi, double yi, double zi, const Block &block,
+                                                    const Parameters &params, double *fi) {
+  const __m128d vxi = _mm_set1_pd(xi);
+  const __m128d vyi = _mm_set1_pd(yi);
+  const __m128d vzi = _mm_set1_pd(zi);
+  const __m128d eps24 = _mm_set1_pd(params.epsilon24);
+  const __m128d sigma2 = _mm_set1_pd(params.sigma2);
+  const __m128d cutoff2 = _mm_set1_pd(params.cutoff2);
+  const __m128d one = _mm_set1_pd(1.0);
+  const __m128d two = _mm_set1_pd(2.0);
+  const __m128d zero = _mm_setzero_pd();
+
+  __m128d fxi = zero;
+  __m128d fyi = zero;
+  __m128d fzi = zero;
+
+  std::size_t j = 0;
+  for (; j + 2 <= block.n; j += 2) {
+    const __m128d dx = _mm_sub_pd(vxi, _mm_loadu_pd(block.x + j));
+    const __m128d dy = _mm_sub_pd(vyi, _mm_loadu_pd(block.y + j));
+    const __m128d dz = _mm_sub_pd(vzi, _mm_loadu_pd(block.z + j));
+    const __m128d r2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+    const __m128d mask = _mm_and_pd(_mm_cmplt_pd(r2, cutoff2), _mm_cmpgt_pd(r2, zero));
+    const __m128d inv_r2 = _mm_div_pd(one, r2);
+    const __m128d sr2 = _mm_mul_pd(sigma2, inv_r2);
+    const __m128d sr6 = _mm_mul_pd(_mm_mul_pd(sr2, sr2), sr2);
+    __m128d scalar = _mm_mul_pd(_mm_mul_pd(eps24, inv_r2), _mm_mul_pd(sr6, _mm_sub_pd(_mm_mul_pd(two, sr6), one)));
+    scalar = _mm_and_pd(scalar, mask);
+
+    const __m128d fx = _mm_mul_pd(scalar, dx);
+    const __m128d fy = _mm_mul_pd(scalar, dy);
+    const __m128d fz = _mm_mul_pd(scalar, dz);
+    fxi = _mm_add_pd(fxi, fx);
+    fyi = _mm_add_pd(fyi, fy);
+    fzi = _mm_add_pd(fzi, fz);
+    _mm_storeu_pd(block.fx + j, _mm_sub_pd(_mm_loadu_pd(block.fx + j), fx));
+    _mm_storeu_pd(block.fy + j, _mm_sub_pd(_mm_loadu_pd(block.fy + j), fy));
+    _mm_storeu_pd(block.fz + j, _mm_sub_pd(_mm_loadu_pd(block.fz + j), fz));
+  }
+
+  alignas(16) double lanes[2];
+  _mm_store_pd(lanes, fxi);
+  fi[0] += lanes[0] + lanes[1];
+  _mm_store_pd(lanes, fyi);
+  fi[1] += lanes[0] + lanes[1];
+  _mm_store_pd(lanes, fzi);
+  fi[2] += lanes[0] + lanes[1];
+
+  scalarRange(xi, yi, zi, block, params, fi, j);
+}
+
+__attribute__((target("avx2,fma"))) void kernelAvx2(double xi, double yi, double zi, const Block &block,
+                                                      const Parameters &params, double *fi) {
+  const __m256d vxi = _mm256_set1_pd(xi);
+  const __m256d vyi = _mm256_set1_pd(yi);
+  const __m256d vzi = _mm256_set1_pd(zi);
+  const __m256d eps24 = _mm256_set1_pd(params.epsilon24);
+  const __m256d sigma2 = _mm256_set1_pd(params.sigma2);
+  const __m256d cutoff2 = _mm256_set1_pd(params.cutoff2);
+  const __m256d one = _mm256_set1_pd(1.0);
+  const __m256d two = _mm256_set1_pd(2.0);
+  const __m256d zero = _mm256_setzero_pd();
+
+  __m256d fxi = zero;
+  __m256d fyi = zero;
+  __m256d fzi = zero;
+
+  std::size_t j = 0;
+  for (; j + 4 <= block.n; j += 4) {
+    const __m256d dx = _mm256_sub_pd(vxi, _mm256_loadu_pd(block.x + j));
+    const __m256d dy = _mm256_sub_pd(vyi, _mm256_loadu_pd(block.y + j));
+    const __m256d dz = _mm256_sub_pd(vzi, _mm256_loadu_pd(block.z + j));
+    const __m256d r2 = _mm256_fmadd_pd(dz, dz, _mm256_fmadd_pd(dy, dy, _mm256_mul_pd(dx, dx)));
+    const __m256d mask =
+        _mm256_and_pd(_mm256_cmp_pd(r2, cutoff2, _CMP_LT_OQ), _mm256_cmp_pd(r2, zero, _CMP_GT_OQ));
+    const __m256d inv_r2 = _mm256_div_pd(one, r2);
+    const __m256d sr2 = _mm256_mul_pd(sigma2, inv_r2);
+    const __m256d sr6 = _mm256_mul_pd(_mm256_mul_pd(sr2, sr2), sr2);
+    __m256d scalar =
+        _mm256_mul_pd(_mm256_mul_pd(eps24, inv_r2), _mm256_mul_pd(sr6, _mm256_fmsub_pd(two, sr6, one)));
+    scalar = _mm256_and_pd(scalar, mask);
+
+    const __m256d fx = _mm256_mul_pd(scalar, dx);
+    const __m256d fy = _mm256_mul_pd(scalar, dy);
+    const __m256d fz = _mm256_mul_pd(scalar, dz);
+    fxi = _mm256_add_pd(fxi, fx);
+    fyi = _mm256_add_pd(fyi, fy);
+    fzi = _mm256_add_pd(fzi, fz);
+    _mm256_storeu_pd(block.fx + j, _mm256_sub_pd(_mm256_loadu_pd(block.fx + j), fx));
+    _mm256_storeu_pd(block.fy + j, _mm256_sub_pd(_mm256_loadu_pd(block.fy + j), fy));
+    _mm256_storeu_pd(block.fz + j, _mm256_sub_pd(_mm256_loadu_pd(block.fz + j), fz));
+  }
+
+  alignas(32) double lanes[4];
+  _mm256_store_pd(lanes, fxi);
+  fi[0] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm256_store_pd(lanes, fyi);
+  fi[1] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+  _mm256_store_pd(lanes, fzi);
+  fi[2] += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+  scalarRange(xi, yi, zi, block, params, fi, j);
+}
+
+__attribute__((target("avx512f"))) void kernelAvx512(double xi, double yi, double zi, const Block &block,
+                                                       const Parameters &params, double *fi) {
+  const __m512d vxi = _mm512_set1_pd(xi);
+  const __m512d vyi = _mm512_set1_pd(yi);
+  const __m512d vzi = _mm512_set1_pd(zi);
+  const __m512d eps24 = _mm512_set1_pd(params.epsilon24);
+  const __m512d sigma2 = _mm512_set1_pd(params.sigma2);
+  const __m512d cutoff2 = _mm512_set1_pd(params.cutoff2);
+  const __m512d one = _mm512_set1_pd(1.0);
+  const __m512d two = _mm512_set1_pd(2.0);
+  const __m512d zero = _mm512_setzero_pd();
+
+  __m512d fxi = zero;
+  __m512d fyi = zero;
+  __m512d fzi = zero;
+
+  // the tail is handled with masked loads and stores instead of a scalar remainder loop
+  for (std::size_t j = 0; j < block.n; j += 8) {
+    const __mmask8 lanes = block.n - j >= 8 ? 0xFF : static_cast<__mmask8>((1u << (block.n - j)) - 1u);
+    const __m512d dx = _mm512_sub_pd(vxi, _mm512_maskz_loadu_pd(lanes, block.x + j));
+    const __m512d dy = _mm512_sub_pd(vyi, _mm512_maskz_loadu_pd(lanes, block.y + j));
+    const __m512d dz = _mm512_sub_pd(vzi, _mm512_maskz_loadu_pd(lanes, block.z + j));
+    const __m512d r2 = _mm512_fmadd_pd(dz, dz, _mm512_fmadd_pd(dy, dy, _mm512_mul_pd(dx, dx)));
+    const __mmask8 mask = lanes & _mm512_cmp_pd_mask(r2, cutoff2, _CMP_LT_OQ) &
+                          _mm512_cmp_pd_mask(r2, zero, _CMP_GT_OQ);
+    const __m512d inv_r2 = _mm512_div_pd(one, r2);
+    const __m512d sr2 = _mm512_mul_pd(sigma2, inv_r2);
+    const __m512d sr6 = _mm512_mul_pd(_mm512_mul_pd(sr2, sr2), sr2);
+    const __m512d scalar = _mm512_maskz_mul_pd(
+        mask, _mm512_mul_pd(eps24, inv_r2), _mm512_mul_pd(sr6, _mm512_fmsub_pd(two, sr6, one)));
+
+    const __m512d fx = _mm512_mul_pd(scalar, dx);
+    const __m512d fy = _mm512_mul_pd(scalar, dy);
+    const __m512d fz = _mm512_mul_pd(scalar, dz);
+    fxi = _mm512_add_pd(fxi, fx);
+    fyi = _mm512_add_pd(fyi, fy);
+    fzi = _mm512_add_pd(fzi, fz);
+    _mm512_mask_storeu_pd(block.fx + j, lanes, _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, block.fx + j), fx));
+    _mm512_mask_storeu_pd(block.fy + j, lanes, _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, block.fy + j), fy));
+    _mm512_mask_storeu_pd(block.fz + j, lanes, _mm512_sub_pd(_mm512_maskz_loadu_pd(lanes, block.fz + j), fz));
+  }
+
+  // horizontal sums through memory; _mm512_reduce_add_pd trips -Wuninitialized in GCC 12 headers
+  alignas(64) double sums[3][8];
+  _mm512_store_pd(sums[0], fxi);
+  _mm512_store_pd(sums[1], fyi);
+  _mm512_store_pd(sums[2], fzi);
+  for (int d = 0; d < 3; ++d) {
+    for (int k = 0; k < 8; ++k) {
+      fi[d] += sums[d][k];
+    }
+  }
+}
+
+#endif
+
+}  // namespace
+
+auto isSupported(Isa isa) -> bool {
+  switch (isa) {
+    case Isa::Scalar:
+      return true;
+#ifdef MOLSIM_X86_DISPATCH
+    case Isa::SSE4:
+      return __builtin_cpu_supports("sse4.1");
+    case Isa::AVX2:
+      return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    case Isa::AVX512:
+      return __builtin_cpu_supports("avx512f");
+#endif
+    default:
+      return false;
+  }
+}
+
+auto detectIsa() -> Isa {
+  for (const auto isa : {Isa::AVX512, Isa::AVX2, Isa::SSE4}) {
+    if (isSupported(isa)) return isa;
+  }
+  return Isa::Scalar;
+}
+
+auto selectKernel(Isa isa) -> KernelFunction {
+  if (!isSupported(isa)) {
+    return kernelScalar;
+  }
+  switch (isa) {
+#ifdef MOLSIM_X86_DISPATCH
+    case Isa::SSE4:
+      return kernelSse4;
+    case Isa::AVX2:
+      return kernelAvx2;
+    case Isa::AVX512:
+      return kernelAvx512;
+#endif
+    default:
+      return kernelScalar;
+  }
+}
+
+auto isaName(Isa isa) -> const char * {
+  switch (isa) {
+    case Isa::SSE4:
+      return "SSE4";
+    case Isa::AVX2:
+      return "AVX2";
+    case Isa::AVX512:
+      return "AVX-512";
+    default:
+      return "scalar";
+  }
+}
+
+}  // namespace LennardJonesKernel
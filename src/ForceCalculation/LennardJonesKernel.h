@@ -0,0 +1,57 @@
+/**
+ * @file LennardJonesKernel.h
+ * @brief Vectorized Lennard-Jones force kernels (one particle against a block of neighbours) with runtime ISA dispatch.
+ */
+#pragma once
+
+#include <cstddef>
+
+namespace LennardJonesKernel {
+
+/// Instruction set used by a kernel.
+enum class Isa { Scalar, SSE4, AVX2, AVX512 };
+
+/**
+ * @brief Neighbour block in structure-of-arrays layout.
+ *
+ * The kernel reads x/y/z and subtracts the pair forces from fx/fy/fz (Newton's third law).
+ */
+struct Block {
+  const double *x;
+  const double *y;
+  const double *z;
+  double *fx;
+  double *fy;
+  double *fz;
+  std::size_t n;
+};
+
+/// Pre-scaled Lennard-Jones parameters shared by all pairs of one kernel call.
+struct Parameters {
+  double epsilon24;  ///< 24 * epsilon
+  double sigma2;     ///< sigma^2
+  double cutoff2;    ///< squared cutoff radius, pairs with r^2 >= cutoff2 do not interact
+};
+
+/**
+ * @brief Kernel signature: accumulate the forces between particle i at (xi, yi, zi) and all block entries.
+ *
+ * The force on particle i is added to fi[0..2]; the opposite force is subtracted from the block.
+ * Only r^2 arithmetic is used (no sqrt, no pow).
+ */
+using KernelFunction = void (*)(double xi, double yi, double zi, const Block &block, const Parameters &params,
+                                double *fi);
+
+/// Best instruction set supported by the executing CPU (CPU feature detection at runtime).
+[[nodiscard]] auto detectIsa() -> Isa;
+
+/// Check whether the executing CPU can run kernels of the given instruction set.
+[[nodiscard]] auto isSupported(Isa isa) -> bool;
+
+/// Kernel compiled for the given instruction set; falls back to the scalar kernel on other architectures.
+[[nodiscard]] auto selectKernel(Isa isa) -> KernelFunction;
+
+/// Human readable name of an instruction set.
+[[nodiscard]] auto isaName(Isa isa) -> const char *;
+
+}  // namespace LennardJonesKernel
@@ -17,13 +17,7 @@ void StormerVerlet::calc(Particle &p1, Particle &p2) {
   p2.setF(ArrayUtils::elementWisePairOp(p2.getF(), newF, std::minus<>()));
 }
 
-void StormerVerlet::calculateF(Container &particles) {
-  // Reset forces
-  for (auto &p : particles) {
-    p.setOldF(p.getF());
-    p.setF({0., 0., 0.});
-  }
-
+void StormerVerlet::addForces(Container &particles) {
   SPDLOG_DEBUG("Recomputing gravitational forces for {} particles (Stormer-Verlet).", particles.size());
 
   // Use pair iterator to calculate forces between each pair of particles.
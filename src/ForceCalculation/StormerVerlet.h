@@ -19,8 +19,8 @@ class StormerVerlet : public ForceCalculation {
    */
   static void calc(Particle &p1, Particle &p2);
   /**
-   * @brief Calculates the forces using the Störmer-Verlet formulas
+   * @brief Adds the forces using the Störmer-Verlet formulas
    * @param particles Particle container on which the calculations are performed
    */
-  void calculateF(Container &particles) override;
+  void addForces(Container &particles) override;
 };
\ No newline at end of file
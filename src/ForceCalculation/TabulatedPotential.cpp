@@ -0,0 +1,203 @@
+#include "TabulatedPotential.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+/// Second derivatives of the natural cubic spline through (x_i, y_i).
+std::vector<double> naturalSpline(const std::vector<double> &x, const std::vector<double> &y) {
+  const std::size_t n = x.size();
+  std::vector<double> m(n, 0.0);
+  if (n < 3) return m;
+
+  // Thomas algorithm for the tridiagonal system of the interior points, m_0 = m_{n-1} = 0
+  std::vector<double> c(n, 0.0);
+  std::vector<double> d(n, 0.0);
+  for (std::size_t i = 1; i + 1 < n; ++i) {
+    const double h0 = x[i] - x[i - 1];
+    const double h1 = x[i + 1] - x[i];
+    const double rhs = 6.0 * ((y[i + 1] - y[i]) / h1 - (y[i] - y[i - 1]) / h0);
+    const double diag = 2.0 * (h0 + h1) - h0 * c[i - 1];
+    c[i] = h1 / diag;
+    d[i] = (rhs - h0 * d[i - 1]) / diag;
+  }
+  for (std::size_t i = n - 2; i > 0; --i) {
+    m[i] = d[i] - c[i] * m[i + 1];
+  }
+  return m;
+}
+
+/// Evaluate the natural cubic spline (x, y, m) at xq; x must be sorted.
+double splineAt(const std::vector<double> &x, const std::vector<double> &y, const std::vector<double> &m, double xq) {
+  const auto upper = std::upper_bound(x.begin(), x.end(), xq);
+  const std::size_t i =
+      std::min<std::size_t>(x.size() - 2, static_cast<std::size_t>(std::max<std::ptrdiff_t>(upper - x.begin() - 1, 0)));
+  const double h = x[i + 1] - x[i];
+  const double t = (xq - x[i]) / h;
+  const double s = 1.0 - t;
+  return s * y[i] + t * y[i + 1] + h * h / 6.0 * ((s * s * s - s) * m[i] + (t * t * t - t) * m[i + 1]);
+}
+
+/// Coefficients of a + t (b + t (c + t d)) for every interval of a uniform spline with unit spacing in t.
+void fillCoefficients(const std::vector<double> &y, const std::vector<double> &m, double h,
+                      const std::function<double *(std::size_t)> &coefficients) {
+  const double h2 = h * h;
+  for (std::size_t i = 0; i + 1 < y.size(); ++i) {
+    double *k = coefficients(i);
+    k[0] = y[i];
+    k[1] = (y[i + 1] - y[i]) - h2 / 6.0 * (2.0 * m[i] + m[i + 1]);
+    k[2] = h2 / 2.0 * m[i];
+    k[3] = h2 / 6.0 * (m[i + 1] - m[i]);
+  }
+}
+
+}  // namespace
+
+TabulatedPotential::TabulatedPotential(const Function &u, const Function &du_dr, double r_min, double r_cutoff,
+                                       std::size_t points) {
+  if (points < 2 || r_min <= 0.0 || r_cutoff <= r_min) {
+    throw std::invalid_argument("TabulatedPotential needs at least 2 points and 0 < r_min < r_cutoff");
+  }
+  r2_min = r_min * r_min;
+  cutoff2 = r_cutoff * r_cutoff;
+  const double dr2 = (cutoff2 - r2_min) / static_cast<double>(points - 1);
+  inv_dr2 = 1.0 / dr2;
+
+  const double shift = u(r_cutoff);
+  std::vector<double> grid(points), f_over_r(points), energy(points);
+  for (std::size_t i = 0; i < points; ++i) {
+    grid[i] = r2_min + static_cast<double>(i) * dr2;
+    const double r = std::sqrt(grid[i]);
+    f_over_r[i] = -du_dr(r) / r;
+    energy[i] = u(r) - shift;
+  }
+
+  segments.resize(points - 1);
+  fillCoefficients(f_over_r, naturalSpline(grid, f_over_r), dr2, [this](std::size_t i) { return segments[i].f; });
+  fillCoefficients(energy, naturalSpline(grid, energy), dr2, [this](std::size_t i) { return segments[i].u; });
+}
+
+TabulatedPotential::~TabulatedPotential() = default;
+
+auto TabulatedPotential::lennardJones(double epsilon, double sigma, double r_min, double r_cutoff, std::size_t points)
+    -> TabulatedPotential {
+  return {[=](double r) {
+            const double sr6 = std::pow(sigma / r, 6);
+            return 4.0 * epsilon * (sr6 * sr6 - sr6);
+          },
+          [=](double r) {
+            const double sr6 = std::pow(sigma / r, 6);
+            return -24.0 * epsilon * sr6 * (2.0 * sr6 - 1.0) / r;
+          },
+          r_min, r_cutoff, points};
+}
+
+auto TabulatedPotential::morse(double depth, double width, double r0, double r_min, double r_cutoff,
+                               std::size_t points) -> TabulatedPotential {
+  return {[=](double r) {
+            const double e = 1.0 - std::exp(-width * (r - r0));
+            return depth * e * e - depth;
+          },
+          [=](double r) {
+            const double e = std::exp(-width * (r - r0));
+            return 2.0 * depth * width * e * (1.0 - e);
+          },
+          r_min, r_cutoff, points};
+}
+
+auto TabulatedPotential::softSphere(double epsilon, double sigma, double exponent, double r_min, double r_cutoff,
+                                    std::size_t points) -> TabulatedPotential {
+  return {[=](double r) { return epsilon * std::pow(sigma / r, exponent); },
+          [=](double r) { return -exponent * epsilon * std::pow(sigma / r, exponent) / r; }, r_min, r_cutoff, points};
+}
+
+auto TabulatedPotential::fromFile(const std::string &path, double r_cutoff, std::size_t points) -> TabulatedPotential {
+  std::ifstream file(path);
+  if (!file) {
+    throw std::runtime_error("Could not open potential table '" + path + "'");
+  }
+
+  std::vector<double> r, u, f;
+  std::string line;
+  while (std::getline(file, line)) {
+    line = line.substr(0, line.find('#'));
+    std::istringstream values(line);
+    double ri, ui, fi;
+    if (values >> ri >> ui >> fi) {
+      r.push_back(ri);
+      u.push_back(ui);
+      f.push_back(fi);
+    }
+  }
+  // a repeated r would give a zero-width interval and an infinite slope
+  if (r.size() < 2 || std::adjacent_find(r.begin(), r.end(), std::greater_equal<>()) != r.end() || r.front() <= 0.0 ||
+      r.back() < r_cutoff) {
+    throw std::runtime_error("Potential table '" + path +
+                             "' needs at least 2 rows with increasing r > 0 that reach the cutoff");
+  }
+
+  const auto mu = naturalSpline(r, u);
+  const auto mf = naturalSpline(r, f);
+  // F = -dU/dr, so the derivative passed on is the negated force column
+  return {[r, u, mu](double x) { return splineAt(r, u, mu, x); },
+          [r, f, mf](double x) { return -splineAt(r, f, mf, x); }, r.front(), r_cutoff, points};
+}
+
+void TabulatedPotential::evaluate(double r2, double &u, double &f_over_r) const {
+  if (r2 >= cutoff2) {
+    u = 0.0;
+    f_over_r = 0.0;
+    return;
+  }
+  const double s = std::max(r2 - r2_min, 0.0) * inv_dr2;
+  const auto i = std::min(static_cast<std::size_t>(s), segments.size() - 1);
+  const double t = s - static_cast<double>(i);
+  const Segment &seg = segments[i];
+  f_over_r = seg.f[0] + t * (seg.f[1] + t * (seg.f[2] + t * seg.f[3]));
+  u = seg.u[0] + t * (seg.u[1] + t * (seg.u[2] + t * seg.u[3]));
+}
+
+double TabulatedPotential::calculateU(const Particle &p1, const Particle &p2) const {
+  const auto &x1 = p1.getX();
+  const auto &x2 = p2.getX();
+  const double dx = x1[0] - x2[0];
+  const double dy = x1[1] - x2[1];
+  const double dz = x1[2] - x2[2];
+  double u, f_over_r;
+  evaluate(dx * dx + dy * dy + dz * dz, u, f_over_r);
+  return u;
+}
+
+void TabulatedPotential::addForces(Container &particles) {
+  particles.forEachPairForce(pairForceFunction());
+}
+
+auto TabulatedPotential::pairForceFunction() const -> Container::PairForce {
+  return [this](const Particle &p1, const Particle &p2) { return pairForce(p1, p2); };
+}
+
+std::array<double, 3> TabulatedPotential::pairForce(const Particle &p1, const Particle &p2) const {
+  const auto &x1 = p1.getX();
+  const auto &x2 = p2.getX();
+  const double dx = x1[0] - x2[0];
+  const double dy = x1[1] - x2[1];
+  const double dz = x1[2] - x2[2];
+  double u, scalar;
+  evaluate(dx * dx + dy * dy + dz * dz, u, scalar);
+  return {scalar * dx, scalar * dy, scalar * dz};
+}
+
+void TabulatedPotential::calc(Particle &p1, Particle &p2) const {
+  const auto force = pairForce(p1, p2);
+
+  // Set the new values making use of Newton's third law
+  const auto &f1 = p1.getF();
+  p1.setF({f1[0] + force[0], f1[1] + force[1], f1[2] + force[2]});
+  const auto &f2 = p2.getF();
+  p2.setF({f2[0] - force[0], f2[1] - force[1], f2[2] - force[2]});
+}
@@ -0,0 +1,98 @@
+/**
+ *@file TabulatedPotential.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "../Container/Particle.h"
+#include "ForceCalculation.h"
+
+/**
+ * Class used to compute forces from tabulated pair potentials
+ *
+ * The force factor F(r)/r and the energy U(r) are sampled once on a uniform grid in r^2 between r_min^2 and
+ * r_c^2 and evaluated with natural cubic splines, so every potential costs one table lookup per pair and needs no
+ * sqrt. The energy is shifted so that U(r_c) = 0; pairs at or beyond the cutoff do not interact and pairs closer
+ * than r_min use the values at r_min. The tables are immutable after construction and can be shared read-only
+ * between threads.
+ */
+class TabulatedPotential : public ForceCalculation {
+ public:
+  /// Radial function of the pair distance r, used for U(r) and dU/dr.
+  using Function = std::function<double(double)>;
+
+  /**
+   * @param u Pair energy U(r)
+   * @param du_dr Derivative dU/dr
+   * @param r_min Smallest tabulated distance
+   * @param r_cutoff Cutoff radius, must be larger than r_min
+   * @param points Number of grid points in r^2 (at least 2)
+   */
+  TabulatedPotential(const Function &u, const Function &du_dr, double r_min, double r_cutoff, std::size_t points);
+  ~TabulatedPotential() override;
+
+  /// Lennard-Jones potential 4 epsilon ((sigma/r)^12 - (sigma/r)^6).
+  static auto lennardJones(double epsilon, double sigma, double r_min, double r_cutoff, std::size_t points)
+      -> TabulatedPotential;
+  /// Morse potential D (1 - exp(-a (r - r0)))^2 - D.
+  static auto morse(double depth, double width, double r0, double r_min, double r_cutoff, std::size_t points)
+      -> TabulatedPotential;
+  /// Purely repulsive soft-sphere potential epsilon (sigma/r)^n.
+  static auto softSphere(double epsilon, double sigma, double exponent, double r_min, double r_cutoff,
+                         std::size_t points) -> TabulatedPotential;
+  /**
+   * @brief User table read from a text file with the columns "r U F" (F = -dU/dr), '#' starts a comment.
+   *
+   * The samples may be non-uniform; they are interpolated with a cubic spline and resampled onto the r^2 grid
+   * starting at the first distance in the file. Throws std::runtime_error if the file cannot be used.
+   */
+  static auto fromFile(const std::string &path, double r_cutoff, std::size_t points) -> TabulatedPotential;
+
+  /**
+   * @brief Interpolated energy and force factor at squared distance r2
+   * @param r2 Squared pair distance
+   * @param u Shifted pair energy
+   * @param f_over_r F(r)/r, the force on the first particle is f_over_r * (x1 - x2)
+   */
+  void evaluate(double r2, double &u, double &f_over_r) const;
+  /**
+   * @brief Tabulated pair energy
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  [[nodiscard]] double calculateU(const Particle &p1, const Particle &p2) const;
+  /**
+   * @brief Adds the forces from the tables
+   * @param particles Particle container on which the calculations are performed
+   */
+  void addForces(Container &particles) override;
+  [[nodiscard]] auto pairForceFunction() const -> Container::PairForce override;
+  /**
+   * @brief Force on p1 from p2 from the tables
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  [[nodiscard]] std::array<double, 3> pairForce(const Particle &p1, const Particle &p2) const;
+  /**
+   * @brief Calculate the force between two particles from the tables
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  void calc(Particle &p1, Particle &p2) const;
+
+ private:
+  /// Cubic coefficients in the local coordinate t in [0, 1) of one grid interval, force and energy interleaved.
+  struct Segment {
+    double f[4];
+    double u[4];
+  };
+
+  std::vector<Segment> segments;
+  double r2_min{};
+  double cutoff2{};
+  double inv_dr2{};
+};
@@ -0,0 +1,98 @@
+#include "TruncatedShiftedLennardJones.h"
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+TruncatedShiftedLennardJones::TruncatedShiftedLennardJones(double epsilon, double sigma, double r_cutoff)
+    : TruncatedShiftedLennardJones(std::vector<TypeParameters>{{epsilon, sigma}}, r_cutoff) {}
+
+TruncatedShiftedLennardJones::TruncatedShiftedLennardJones(const std::vector<TypeParameters> &types, double r_cutoff)
+    : matrix(types.size() * types.size()), num_types(types.size()) {
+  const double cutoff2 = r_cutoff > 0.0 ? r_cutoff * r_cutoff : std::numeric_limits<double>::infinity();
+  for (std::size_t i = 0; i < num_types; ++i) {
+    for (std::size_t j = 0; j < num_types; ++j) {
+      // Lorentz-Berthelot mixing: arithmetic mean of sigma, geometric mean of epsilon
+      const double epsilon = std::sqrt(types[i].epsilon * types[j].epsilon);
+      const double sigma = 0.5 * (types[i].sigma + types[j].sigma);
+      auto &entry = matrix[i * num_types + j];
+      entry.epsilon24 = 24.0 * epsilon;
+      entry.epsilon4 = 4.0 * epsilon;
+      entry.sigma2 = sigma * sigma;
+      entry.cutoff2 = cutoff2;
+      const double sr2 = entry.sigma2 / cutoff2;
+      const double sr6 = sr2 * sr2 * sr2;
+      entry.shift = r_cutoff > 0.0 ? entry.epsilon4 * (sr6 * sr6 - sr6) : 0.0;
+    }
+  }
+}
+TruncatedShiftedLennardJones::~TruncatedShiftedLennardJones() = default;
+
+void TruncatedShiftedLennardJones::checkType(int type) const {
+  if (static_cast<std::size_t>(type) >= num_types) {
+    throw std::out_of_range("No Lennard-Jones parameters for particle type " + std::to_string(type));
+  }
+}
+
+void TruncatedShiftedLennardJones::checkTypes(const Container &particles) const {
+  for (const auto &p : particles) {
+    checkType(p.getType());
+  }
+}
+
+double TruncatedShiftedLennardJones::calculateU(const Particle &p1, const Particle &p2) const {
+  const auto &x1 = p1.getX();
+  const auto &x2 = p2.getX();
+  const double dx = x1[0] - x2[0];
+  const double dy = x1[1] - x2[1];
+  const double dz = x1[2] - x2[2];
+  const double r2 = dx * dx + dy * dy + dz * dz;
+  checkType(p1.getType());
+  checkType(p2.getType());
+  const auto &pair = getPairParameters(p1.getType(), p2.getType());
+  if (r2 >= pair.cutoff2 || r2 == 0.0) {
+    return 0.0;
+  }
+  const double sr2 = pair.sigma2 / r2;
+  const double sr6 = sr2 * sr2 * sr2;
+  return pair.epsilon4 * (sr6 * sr6 - sr6) - pair.shift;
+}
+
+void TruncatedShiftedLennardJones::addForces(Container &particles) {
+  // once per call instead of per pair, the pair kernel indexes the matrix unchecked
+  checkTypes(particles);
+  particles.forEachPairForce(pairForceFunction());
+}
+
+auto TruncatedShiftedLennardJones::pairForceFunction() const -> Container::PairForce {
+  return [this](const Particle &p1, const Particle &p2) { return pairForce(p1, p2); };
+}
+
+std::array<double, 3> TruncatedShiftedLennardJones::pairForce(const Particle &p1, const Particle &p2) const {
+  const auto &x1 = p1.getX();
+  const auto &x2 = p2.getX();
+  const double dx = x1[0] - x2[0];
+  const double dy = x1[1] - x2[1];
+  const double dz = x1[2] - x2[2];
+  const double r2 = dx * dx + dy * dy + dz * dz;
+  const auto &pair = getPairParameters(p1.getType(), p2.getType());
+
+  // 1 inside the cutoff, 0 outside or for coincident particles; the mask also keeps the division finite
+  const double inside = static_cast<double>((r2 < pair.cutoff2) & (r2 > 0.0));
+  const double inv_r2 = inside / (r2 + (1.0 - inside));
+  const double sr2 = pair.sigma2 * inv_r2;
+  const double sr6 = sr2 * sr2 * sr2;
+  const double scalar = pair.epsilon24 * inv_r2 * sr6 * (2.0 * sr6 - 1.0);
+  return {scalar * dx, scalar * dy, scalar * dz};
+}
+
+void TruncatedShiftedLennardJones::calc(Particle &p1, Particle &p2) const {
+  const auto force = pairForce(p1, p2);
+
+  // Set the new values making use of Newton's third law
+  const auto &f1 = p1.getF();
+  p1.setF({f1[0] + force[0], f1[1] + force[1], f1[2] + force[2]});
+  const auto &f2 = p2.getF();
+  p2.setF({f2[0] - force[0], f2[1] - force[1], f2[2] - force[2]});
+}
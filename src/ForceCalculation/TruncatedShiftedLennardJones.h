@@ -0,0 +1,102 @@
+/**
+ *@file TruncatedShiftedLennardJones.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../Container/Particle.h"
+#include "ForceCalculation.h"
+
+/**
+ * Class used to compute forces using the truncated and shifted Lennard-Jones potential
+ *
+ * U(r) = 4 epsilon ((sigma/r)^12 - (sigma/r)^6) - U_LJ(r_c) for r < r_c and 0 otherwise, so the energy is
+ * continuous at the cutoff and the force is -dU/dr everywhere. Only squared distances are used: the cutoff
+ * test is r^2 < r_c^2 and (sigma/r)^6 is computed as (sigma^2 / r^2)^3.
+ *
+ * Several particle types are supported through a dense type x type matrix of mixed parameters (Lorentz-Berthelot
+ * rules), precomputed at construction, so a pair costs one indexed load regardless of the number of species.
+ */
+class TruncatedShiftedLennardJones : public ForceCalculation {
+ public:
+  /// Lennard-Jones parameters of a single particle type.
+  struct TypeParameters {
+    double epsilon;
+    double sigma;
+  };
+
+  /// Mixed, pre-scaled parameters of one type pair.
+  struct PairParameters {
+    double epsilon24;  ///< 24 * epsilon_ij
+    double epsilon4;   ///< 4 * epsilon_ij
+    double sigma2;     ///< sigma_ij^2
+    double cutoff2;    ///< squared cutoff radius
+    double shift;      ///< U_LJ(r_c) subtracted inside the cutoff
+  };
+
+  /**
+   * @param epsilon Depth of the potential well
+   * @param sigma Zero crossing of the potential
+   * @param r_cutoff Cutoff radius, a value <= 0 disables truncation and shift
+   */
+  TruncatedShiftedLennardJones(double epsilon, double sigma, double r_cutoff);
+  /**
+   * @param types Parameters of the particle types 0 .. types.size() - 1
+   * @param r_cutoff Cutoff radius, a value <= 0 disables truncation and shift
+   */
+  TruncatedShiftedLennardJones(const std::vector<TypeParameters> &types, double r_cutoff);
+  ~TruncatedShiftedLennardJones() override;
+  /// Number of particle types covered by the parameter matrix.
+  [[nodiscard]] std::size_t getNumTypes() const { return num_types; }
+  /// Mixed parameters of the type pair (t1, t2).
+  [[nodiscard]] const PairParameters &getPairParameters(int t1, int t2) const {
+    return matrix[static_cast<std::size_t>(t1) * num_types + static_cast<std::size_t>(t2)];
+  }
+  /// Energy shift U_LJ(r_c) of type 0 subtracted inside the cutoff.
+  [[nodiscard]] double getShift() const { return matrix.front().shift; }
+  /**
+   * @brief Throws std::out_of_range if a particle has a type without parameters
+   *
+   * addForces runs this check before the traversal; callers of pairForceFunction or pairForce have to run it
+   * themselves, the pair kernel does not check the types.
+   * @param particles Particles whose types are checked
+   */
+  void checkTypes(const Container &particles) const;
+  /**
+   * @brief Shifted pair energy, 0 at and beyond the cutoff
+   *
+   * Throws std::out_of_range if a particle has a type without parameters.
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  [[nodiscard]] double calculateU(const Particle &p1, const Particle &p2) const;
+  /**
+   * @brief Adds the forces using the truncated Lennard-Jones force
+   *
+   * Throws std::out_of_range if a particle has a type without parameters.
+   * @param particles Particle container on which the calculations are performed
+   */
+  void addForces(Container &particles) override;
+  [[nodiscard]] auto pairForceFunction() const -> Container::PairForce override;
+  /**
+   * @brief Force on p1 from p2 without branches on the distance
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  [[nodiscard]] std::array<double, 3> pairForce(const Particle &p1, const Particle &p2) const;
+  /**
+   * @brief Calculate the force between two particles without branches on the distance
+   * @param p1 First particle
+   * @param p2 Second particle
+   */
+  void calc(Particle &p1, Particle &p2) const;
+
+ private:
+  /// Throws std::out_of_range if the type has no parameters.
+  void checkType(int type) const;
+
+  std::vector<PairParameters> matrix;
+  std::size_t num_types{};
+};
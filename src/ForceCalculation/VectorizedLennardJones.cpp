@@ -0,0 +1,99 @@
+#include "VectorizedLennardJones.h"
+
+#include <spdlog/spdlog.h>
+
+#include <limits>
+
+VectorizedLennardJones::VectorizedLennardJones(double epsilon, double sigma, double r_cutoff)
+    : VectorizedLennardJones(epsilon, sigma, r_cutoff, LennardJonesKernel::detectIsa()) {}
+
+VectorizedLennardJones::VectorizedLennardJones(double epsilon, double sigma, double r_cutoff,
+                                               LennardJonesKernel::Isa isa)
+    : isa_(LennardJonesKernel::isSupported(isa) ? isa : LennardJonesKernel::Isa::Scalar),
+      kernel_(LennardJonesKernel::selectKernel(isa_)) {
+  params_.epsilon24 = 24.0 * epsilon;
+  params_.sigma2 = sigma * sigma;
+  params_.cutoff2 = r_cutoff > 0.0 ? r_cutoff * r_cutoff : std::numeric_limits<double>::infinity();
+  SPDLOG_INFO("Vectorized Lennard-Jones kernel uses {} instructions.", LennardJonesKernel::isaName(isa_));
+}
+
+VectorizedLennardJones::~VectorizedLennardJones() = default;
+
+void VectorizedLennardJones::addForces(Container &particles) {
+  auto *linked_cells = dynamic_cast<LinkedCellContainer *>(&particles);
+  if (linked_cells) {
+    std::vector<CellLists::Range> cells;
+    cells.reserve(linked_cells->numCells());
+    for (std::size_t c = 0; c < linked_cells->numCells(); ++c) {
+      cells.push_back(linked_cells->cellParticles(c));
+    }
+    gather(cells);
+    linked_cells->forEachCellPair([this](std::size_t a, std::size_t b) { interact(a, b); });
+  } else {
+    // Without a cell structure all particles form a single block.
+    std::vector<Particle *> all;
+    all.reserve(particles.size());
+    for (auto &p : particles) {
+      all.push_back(&p);
+    }
+    gather({CellLists::Range(all.data(), all.data() + all.size())});
+    interact(0, 0);
+  }
+
+  scatter();
+  if (linked_cells) {
+    linked_cells->finishPairForces();
+  }
+}
+
+void VectorizedLennardJones::gather(const std::vector<CellLists::Range> &cells) {
+  particles_.clear();
+  cell_start_.assign(cells.size() + 1, 0);
+  for (std::size_t c = 0; c < cells.size(); ++c) {
+    cell_start_[c] = particles_.size();
+    particles_.insert(particles_.end(), cells[c].begin(), cells[c].end());
+  }
+  cell_start_[cells.size()] = particles_.size();
+
+  const auto n = particles_.size();
+  x_.resize(n);
+  y_.resize(n);
+  z_.resize(n);
+  fx_.assign(n, 0.0);
+  fy_.assign(n, 0.0);
+  fz_.assign(n, 0.0);
+  for (std::size_t i = 0; i < n; ++i) {
+    const auto &pos = particles_[i]->getX();
+    x_[i] = pos[0];
+    y_[i] = pos[1];
+    z_[i] = pos[2];
+  }
+}
+
+void VectorizedLennardJones::interact(std::size_t a, std::size_t b) {
+  const auto a_begin = cell_start_[a];
+  const auto a_end = cell_start_[a + 1];
+
+  for (std::size_t i = a_begin; i < a_end; ++i) {
+    // the self interaction only looks at the particles after i to visit every pair once
+    const auto b_begin = a == b ? i + 1 : cell_start_[b];
+    const auto b_end = cell_start_[b + 1];
+    if (b_begin >= b_end) continue;
+
+    const LennardJonesKernel::Block block{x_.data() + b_begin,  y_.data() + b_begin,  z_.data() + b_begin,
+                                          fx_.data() + b_begin, fy_.data() + b_begin, fz_.data() + b_begin,
+                                          b_end - b_begin};
+    double fi[3] = {0.0, 0.0, 0.0};
+    kernel_(x_[i], y_[i], z_[i], block, params_, fi);
+    fx_[i] += fi[0];
+    fy_[i] += fi[1];
+    fz_[i] += fi[2];
+  }
+}
+
+void VectorizedLennardJones::scatter() {
+  for (std::size_t i = 0; i < particles_.size(); ++i) {
+    const auto &f = particles_[i]->getF();
+    particles_[i]->setF({f[0] + fx_[i], f[1] + fy_[i], f[2] + fz_[i]});
+  }
+}
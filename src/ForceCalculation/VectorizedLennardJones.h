@@ -0,0 +1,57 @@
+/**
+ *@file VectorizedLennardJones.h
+ */
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "../Container/LinkedCellContainer.h"
+#include "ForceCalculation.h"
+#include "LennardJonesKernel.h"
+#include "utils/HugePages.h"
+
+/**
+ * Class used to compute Lennard-Jones forces with SIMD kernels.
+ *
+ * Particle positions are gathered cell by cell into structure-of-arrays buffers once per step; every cell pair
+ * of the linked-cell traversal is then processed as "particle against a block of neighbours" by the kernel
+ * matching the CPU (selected at runtime). Forces are scattered back to the particles at the end.
+ */
+class VectorizedLennardJones : public ForceCalculation {
+ public:
+  /**
+   * @param epsilon Depth of the potential well
+   * @param sigma Zero crossing of the potential
+   * @param r_cutoff Cutoff radius, a value <= 0 disables the cutoff
+   */
+  VectorizedLennardJones(double epsilon, double sigma, double r_cutoff);
+  /**
+   * @brief Same as above, but with an explicitly chosen instruction set (falls back to scalar if unsupported).
+   */
+  VectorizedLennardJones(double epsilon, double sigma, double r_cutoff, LennardJonesKernel::Isa isa);
+  ~VectorizedLennardJones() override;
+  /**
+   * @brief Adds the forces using the vectorized Lennard-Jones kernel
+   * @param particles Particle container on which the calculations are performed
+   */
+  void addForces(Container &particles) override;
+  /// Instruction set of the kernel in use.
+  [[nodiscard]] auto getIsa() const -> LennardJonesKernel::Isa { return isa_; }
+
+ private:
+  /// Gather the positions of all particles, grouped by cell, into the SoA buffers.
+  void gather(const std::vector<CellLists::Range> &cells);
+  /// Process the cell pair (a, b) of the gathered buffers; a == b is the self interaction.
+  void interact(std::size_t a, std::size_t b);
+  /// Add the accumulated forces to the particles.
+  void scatter();
+
+  LennardJonesKernel::Isa isa_;
+  LennardJonesKernel::KernelFunction kernel_;
+  LennardJonesKernel::Parameters params_{};
+
+  LargeVector<Particle *> particles_;
+  LargeVector<std::size_t> cell_start_;
+  LargeVector<double> x_, y_, z_, fx_, fy_, fz_;
+};
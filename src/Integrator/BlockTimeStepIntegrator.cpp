@@ -0,0 +1,145 @@
+/**
+ * @file BlockTimeStepIntegrator.cpp
+ * @brief Implementation of the hierarchical block time step integrator.
+ */
+#include "BlockTimeStepIntegrator.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+BlockTimeStepIntegrator::BlockTimeStepIntegrator(double delta_t, int max_level, double eta)
+    : delta_t_(delta_t), max_level_(max_level), eta_(eta) {}
+
+auto BlockTimeStepIntegrator::stepSize(int level) const -> double { return std::ldexp(delta_t_, -level); }
+
+void BlockTimeStepIntegrator::initialize(Container &particles) {
+  bodies_.clear();
+  for (auto &p : particles) {
+    bodies_.push_back(&p);
+  }
+
+  const auto n = bodies_.size();
+  acc_.assign(n, {0., 0., 0.});
+  timescale_.assign(n, std::numeric_limits<double>::infinity());
+  level_.assign(n, 0);
+  pending_kick_.assign(n, true);
+  tick_ = 0;
+
+  for (std::size_t i = 0; i < n; ++i) {
+    computeAcceleration(i);
+    level_[i] = desiredLevel(i);
+  }
+}
+
+void BlockTimeStepIntegrator::computeAcceleration(std::size_t i) {
+  const auto &xi = bodies_[i]->getX();
+  const auto &vi = bodies_[i]->getV();
+  const double mi = bodies_[i]->getM();
+
+  std::array<double, 3> a{0., 0., 0.};
+  double tau = std::numeric_limits<double>::infinity();
+
+  for (std::size_t j = 0; j < bodies_.size(); ++j) {
+    if (j == i) continue;
+    const auto &xj = bodies_[j]->getX();
+    const auto &vj = bodies_[j]->getV();
+    const double mj = bodies_[j]->getM();
+
+    const std::array<double, 3> d{xj[0] - xi[0], xj[1] - xi[1], xj[2] - xi[2]};
+    const double r2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    const double r = std::sqrt(r2);
+    const double inv_r3 = 1.0 / (r2 * r);
+
+    for (int k = 0; k < 3; ++k) {
+      a[k] += mj * d[k] * inv_r3;
+    }
+
+    // free-fall time and fly-by time of the pair
+    const std::array<double, 3> dv{vj[0] - vi[0], vj[1] - vi[1], vj[2] - vi[2]};
+    const double v2 = dv[0] * dv[0] + dv[1] * dv[1] + dv[2] * dv[2];
+    tau = std::min(tau, std::sqrt(r2 * r / (mi + mj)));
+    if (v2 > 0.0) {
+      tau = std::min(tau, r / std::sqrt(v2));
+    }
+  }
+
+  acc_[i] = a;
+  timescale_[i] = tau;
+  bodies_[i]->setF({mi * a[0], mi * a[1], mi * a[2]});
+  ++force_evaluations_;
+}
+
+auto BlockTimeStepIntegrator::desiredLevel(std::size_t i) const -> int {
+  const double dt = eta_ * timescale_[i];
+  if (!std::isfinite(dt) || dt >= delta_t_) {
+    return 0;
+  }
+  const auto level = static_cast<int>(std::ceil(std::log2(delta_t_ / dt)));
+  return std::clamp(level, 0, max_level_);
+}
+
+void BlockTimeStepIntegrator::step(Container &particles) {
+  if (bodies_.size() != particles.size() || bodies_.empty()) {
+    initialize(particles);
+  }
+
+  const double dt_min = stepSize(max_level_);
+  const std::uint64_t end_tick = tick_ + ticksPerStep(0);
+  int finest_level = *std::max_element(level_.begin(), level_.end());
+
+  while (tick_ < end_tick) {
+    // opening half kicks of the bodies that started a new step at the previous block boundary
+    for (std::size_t i = 0; i < bodies_.size(); ++i) {
+      if (!pending_kick_[i]) continue;
+      const double half = 0.5 * stepSize(level_[i]);
+      const auto &v = bodies_[i]->getV();
+      bodies_[i]->setV({v[0] + half * acc_[i][0], v[1] + half * acc_[i][1], v[2] + half * acc_[i][2]});
+      pending_kick_[i] = false;
+    }
+
+    // jump directly to the next block boundary at which any body is due
+    std::uint64_t next_tick = end_tick;
+    for (const int level : level_) {
+      const auto t = ticksPerStep(level);
+      next_tick = std::min(next_tick, (tick_ / t + 1) * t);
+    }
+
+    // all bodies drift together so positions stay synchronized
+    const double dt = static_cast<double>(next_tick - tick_) * dt_min;
+    for (auto *p : bodies_) {
+      const auto &x = p->getX();
+      const auto &v = p->getV();
+      p->setX({x[0] + dt * v[0], x[1] + dt * v[1], x[2] + dt * v[2]});
+    }
+    tick_ = next_tick;
+
+    // forces are only evaluated for the bodies whose step ends now
+    for (std::size_t i = 0; i < bodies_.size(); ++i) {
+      if (tick_ % ticksPerStep(level_[i]) != 0) continue;
+
+      computeAcceleration(i);
+
+      const double half = 0.5 * stepSize(level_[i]);
+      const auto &v = bodies_[i]->getV();
+      bodies_[i]->setV({v[0] + half * acc_[i][0], v[1] + half * acc_[i][1], v[2] + half * acc_[i][2]});
+
+      // refining is always possible, coarsening only where the coarser block boundary is reached
+      int level = desiredLevel(i);
+      while (level < level_[i] && tick_ % ticksPerStep(level) != 0) {
+        ++level;
+      }
+      level_[i] = level;
+      pending_kick_[i] = true;
+      finest_level = std::max(finest_level, level);
+    }
+  }
+
+  // a global scheme would have needed the finest step in use for every body
+  global_evaluations_ += bodies_.size() * (std::uint64_t{1} << finest_level);
+
+  SPDLOG_DEBUG("Block time step finished: {} force evaluations so far ({} with a global finest step).",
+               force_evaluations_, global_evaluations_);
+}
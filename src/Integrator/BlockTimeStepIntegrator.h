@@ -0,0 +1,67 @@
+/**
+ * @file BlockTimeStepIntegrator.h
+ * @brief Hierarchical (power-of-two) individual time steps for gravitational systems.
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "../Container/Container.h"
+
+/**
+ * @brief Leapfrog (kick-drift-kick) integrator with per-body block time steps.
+ *
+ * The base step delta_t is split into 2^maxLevel ticks. A body on level L advances with
+ * delta_t / 2^L, i.e. it is due every 2^(maxLevel - L) ticks. All bodies drift together from one
+ * block boundary to the next (cheap), but gravitational accelerations are only evaluated for the
+ * bodies that are due.
+ * Levels are chosen from the shortest free-fall / fly-by time to any other body, scaled by eta.
+ * After every call to step() all velocities are synchronized with the positions.
+ */
+class BlockTimeStepIntegrator {
+ public:
+  /**
+   * @param delta_t Base (largest) time step
+   * @param max_level Number of halvings of the base step available to the bodies
+   * @param eta Accuracy parameter, dt_i = eta * tau_i
+   */
+  BlockTimeStepIntegrator(double delta_t, int max_level, double eta);
+
+  /**
+   * @brief Advance all particles by one base step delta_t.
+   * @param particles Container holding the bodies; it must not change size between calls
+   */
+  void step(Container &particles);
+
+  /// Number of single-body force evaluations (each one sums over all other bodies).
+  [[nodiscard]] auto getForceEvaluations() const -> std::uint64_t { return force_evaluations_; }
+
+  /// Number of evaluations a global step equal to the finest step in use would have needed for the same span.
+  [[nodiscard]] auto getGlobalStepEvaluations() const -> std::uint64_t { return global_evaluations_; }
+
+  /// Current time step level of each body (container order).
+  [[nodiscard]] auto getLevels() const -> const std::vector<int> & { return level_; }
+
+ private:
+  void initialize(Container &particles);
+  void computeAcceleration(std::size_t i);
+  [[nodiscard]] auto desiredLevel(std::size_t i) const -> int;
+  [[nodiscard]] auto ticksPerStep(int level) const -> std::uint64_t { return std::uint64_t{1} << (max_level_ - level); }
+  [[nodiscard]] auto stepSize(int level) const -> double;
+
+  double delta_t_;
+  int max_level_;
+  double eta_;
+
+  std::vector<Particle *> bodies_;
+  std::vector<std::array<double, 3>> acc_;
+  std::vector<double> timescale_;
+  std::vector<int> level_;
+  std::vector<bool> pending_kick_;
+
+  std::uint64_t tick_{0};
+  std::uint64_t force_evaluations_{0};
+  std::uint64_t global_evaluations_{0};
+};
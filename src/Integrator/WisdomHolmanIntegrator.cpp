@@ -0,0 +1,235 @@
+/**
+ * @file WisdomHolmanIntegrator.cpp
+ * @brief Implementation of the Wisdom-Holman integrator.
+ */
+#include "WisdomHolmanIntegrator.h"
+
+#include <spdlog/spdlog.h>
+
+#include <cmath>
+
+namespace {
+
+/// Stumpff functions c0..c3 evaluated at z (series expansion around z = 0 to avoid cancellation).
+void stumpff(double z, double &c0, double &c1, double &c2, double &c3) {
+  if (std::abs(z) < 1e-2) {
+    c3 = (1.0 - z / 20.0 * (1.0 - z / 42.0 * (1.0 - z / 72.0 * (1.0 - z / 110.0)))) / 6.0;
+    c2 = (1.0 - z / 12.0 * (1.0 - z / 30.0 * (1.0 - z / 56.0 * (1.0 - z / 90.0)))) / 2.0;
+    c1 = 1.0 - z * c3;
+    c0 = 1.0 - z * c2;
+  } else if (z > 0.0) {
+    const double sz = std::sqrt(z);
+    c0 = std::cos(sz);
+    c1 = std::sin(sz) / sz;
+    c2 = (1.0 - c0) / z;
+    c3 = (1.0 - c1) / z;
+  } else {
+    const double sz = std::sqrt(-z);
+    c0 = std::cosh(sz);
+    c1 = std::sinh(sz) / sz;
+    c2 = (1.0 - c0) / z;
+    c3 = (1.0 - c1) / z;
+  }
+}
+
+double dot(const std::array<double, 3> &a, const std::array<double, 3> &b) {
+  return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+}  // namespace
+
+WisdomHolmanIntegrator::WisdomHolmanIntegrator(double delta_t) : delta_t_(delta_t) {}
+
+void WisdomHolmanIntegrator::keplerDrift(std::array<double, 3> &x, std::array<double, 3> &v, double mu, double dt) {
+  const double r0 = std::sqrt(dot(x, x));
+  if (r0 == 0.0 || mu <= 0.0) {
+    for (int k = 0; k < 3; ++k) x[k] += dt * v[k];
+    return;
+  }
+  const double eta = dot(x, v);
+  const double beta = 2.0 * mu / r0 - dot(v, v);
+
+  // Solve the universal Kepler equation r0*G1 + eta*G2 + mu*G3 = dt for s (Halley iteration).
+  double s = dt / r0;
+  double c0 = 1.0;
+  double c1 = 1.0;
+  double c2 = 0.5;
+  double c3 = 1.0 / 6.0;
+  bool converged = false;
+  for (int iter = 0; iter < 50; ++iter) {
+    stumpff(beta * s * s, c0, c1, c2, c3);
+    const double g1 = s * c1;
+    const double g2 = s * s * c2;
+    const double g3 = s * s * s * c3;
+    const double f = r0 * g1 + eta * g2 + mu * g3 - dt;
+    const double fp = r0 * c0 + eta * g1 + mu * g2;
+    const double fpp = eta * c0 + (mu - beta * r0) * g1;
+    const double ds = -2.0 * f * fp / (2.0 * fp * fp - f * fpp);
+    s += ds;
+    if (std::abs(ds) <= 1e-15 * std::abs(s)) {
+      converged = true;
+      break;
+    }
+  }
+  if (!converged) {
+    SPDLOG_WARN("Kepler solver did not converge (dt={}, r={}).", dt, r0);
+  }
+
+  stumpff(beta * s * s, c0, c1, c2, c3);
+  const double g1 = s * c1;
+  const double g2 = s * s * c2;
+  const double g3 = s * s * s * c3;
+  const double r = r0 * c0 + eta * g1 + mu * g2;
+
+  const double f = 1.0 - mu * g2 / r0;
+  const double g = dt - mu * g3;
+  const double fdot = -mu * g1 / (r * r0);
+  const double gdot = 1.0 - mu * g2 / r;
+
+  const auto x0 = x;
+  const auto v0 = v;
+  for (int k = 0; k < 3; ++k) {
+    x[k] = f * x0[k] + g * v0[k];
+    v[k] = fdot * x0[k] + gdot * v0[k];
+  }
+}
+
+void WisdomHolmanIntegrator::initialize(Container &particles) {
+  bodies_.clear();
+  for (auto &p : particles) {
+    bodies_.push_back(&p);
+  }
+  const auto n = bodies_.size();
+
+  central_ = 0;
+  total_mass_ = 0.0;
+  x_cm_ = {0., 0., 0.};
+  v_cm_ = {0., 0., 0.};
+  for (std::size_t i = 0; i < n; ++i) {
+    const double m = bodies_[i]->getM();
+    if (m > bodies_[central_]->getM()) central_ = i;
+    total_mass_ += m;
+    for (int k = 0; k < 3; ++k) {
+      x_cm_[k] += m * bodies_[i]->getX()[k];
+      v_cm_[k] += m * bodies_[i]->getV()[k];
+    }
+  }
+  for (int k = 0; k < 3; ++k) {
+    x_cm_[k] /= total_mass_;
+    v_cm_[k] /= total_mass_;
+  }
+
+  q_.assign(n, {0., 0., 0.});
+  u_.assign(n, {0., 0., 0.});
+  acc_.assign(n, {0., 0., 0.});
+  const auto &xc = bodies_[central_]->getX();
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i == central_) continue;
+    for (int k = 0; k < 3; ++k) {
+      q_[i][k] = bodies_[i]->getX()[k] - xc[k];
+      u_[i][k] = bodies_[i]->getV()[k] - v_cm_[k];
+    }
+  }
+}
+
+void WisdomHolmanIntegrator::interactionKick(double dt) {
+  const auto n = bodies_.size();
+  for (auto &a : acc_) a = {0., 0., 0.};
+
+  for (std::size_t i = 0; i < n; ++i) {
+    if (i == central_) continue;
+    for (std::size_t j = i + 1; j < n; ++j) {
+      if (j == central_) continue;
+      std::array<double, 3> d{q_[j][0] - q_[i][0], q_[j][1] - q_[i][1], q_[j][2] - q_[i][2]};
+      const double r2 = dot(d, d);
+      const double inv_r3 = 1.0 / (r2 * std::sqrt(r2));
+      const double mi = bodies_[i]->getM();
+      const double mj = bodies_[j]->getM();
+      for (int k = 0; k < 3; ++k) {
+        acc_[i][k] += mj * d[k] * inv_r3;
+        acc_[j][k] -= mi * d[k] * inv_r3;
+      }
+    }
+  }
+
+  for (std::size_t i = 0; i < n; ++i) {
+    for (int k = 0; k < 3; ++k) u_[i][k] += dt * acc_[i][k];
+  }
+}
+
+void WisdomHolmanIntegrator::centralJump(double dt) {
+  std::array<double, 3> p{0., 0., 0.};
+  for (std::size_t i = 0; i < bodies_.size(); ++i) {
+    if (i == central_) continue;
+    for (int k = 0; k < 3; ++k) p[k] += bodies_[i]->getM() * u_[i][k];
+  }
+  const double scale = dt / bodies_[central_]->getM();
+  for (std::size_t i = 0; i < bodies_.size(); ++i) {
+    if (i == central_) continue;
+    for (int k = 0; k < 3; ++k) q_[i][k] += scale * p[k];
+  }
+}
+
+void WisdomHolmanIntegrator::writeBack() {
+  const double mc = bodies_[central_]->getM();
+
+  std::array<double, 3> xc = x_cm_;
+  std::array<double, 3> uc{0., 0., 0.};
+  std::array<double, 3> fc{0., 0., 0.};
+  for (std::size_t i = 0; i < bodies_.size(); ++i) {
+    if (i == central_) continue;
+    const double m = bodies_[i]->getM();
+    for (int k = 0; k < 3; ++k) {
+      xc[k] -= m * q_[i][k] / total_mass_;
+      uc[k] -= m * u_[i][k] / mc;
+    }
+  }
+
+  for (std::size_t i = 0; i < bodies_.size(); ++i) {
+    if (i == central_) continue;
+    const double m = bodies_[i]->getM();
+    const double r2 = dot(q_[i], q_[i]);
+    const double kepler = mc / (r2 * std::sqrt(r2));
+    std::array<double, 3> x{};
+    std::array<double, 3> v{};
+    std::array<double, 3> f{};
+    for (int k = 0; k < 3; ++k) {
+      x[k] = q_[i][k] + xc[k];
+      v[k] = u_[i][k] + v_cm_[k];
+      f[k] = m * (acc_[i][k] - kepler * q_[i][k]);
+      fc[k] += m * kepler * q_[i][k];
+    }
+    bodies_[i]->setX(x);
+    bodies_[i]->setV(v);
+    bodies_[i]->setF(f);
+  }
+
+  bodies_[central_]->setX(xc);
+  bodies_[central_]->setV({uc[0] + v_cm_[0], uc[1] + v_cm_[1], uc[2] + v_cm_[2]});
+  bodies_[central_]->setF(fc);
+}
+
+void WisdomHolmanIntegrator::step(Container &particles) {
+  if (bodies_.size() != particles.size() || bodies_.empty()) {
+    initialize(particles);
+  }
+  if (bodies_.empty()) {
+    return;
+  }
+
+  const double half = 0.5 * delta_t_;
+  const double mu = bodies_[central_]->getM();
+
+  interactionKick(half);
+  centralJump(half);
+  for (std::size_t i = 0; i < bodies_.size(); ++i) {
+    if (i == central_) continue;
+    keplerDrift(q_[i], u_[i], mu, delta_t_);
+  }
+  centralJump(half);
+  interactionKick(half);
+
+  for (int k = 0; k < 3; ++k) x_cm_[k] += delta_t_ * v_cm_[k];
+
+  writeBack();
+}
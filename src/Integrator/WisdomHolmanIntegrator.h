@@ -0,0 +1,58 @@
+/**
+ * @file WisdomHolmanIntegrator.h
+ * @brief Wisdom-Holman mixed-variable symplectic integrator for systems dominated by one central mass.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include "../Container/Container.h"
+
+/**
+ * @brief Wisdom-Holman integrator in democratic heliocentric coordinates.
+ *
+ * The Hamiltonian is split into the Kepler motion of every body around the central (most massive)
+ * body, the mutual interactions of the orbiting bodies and the motion of the central body. Each step
+ * is the symmetric composition kick(dt/2) jump(dt/2) kepler(dt) jump(dt/2) kick(dt/2): the Kepler part is
+ * solved analytically with universal variables, so only the small mutual perturbations are integrated
+ * numerically. This allows steps far larger than Störmer-Verlet needs for the same energy error.
+ * Gravitational constant G = 1, consistent with StormerVerlet.
+ */
+class WisdomHolmanIntegrator {
+ public:
+  explicit WisdomHolmanIntegrator(double delta_t);
+
+  /**
+   * @brief Advance all particles by one step delta_t.
+   * @param particles Container holding the bodies; it must not change size between calls
+   */
+  void step(Container &particles);
+
+  /**
+   * @brief Propagate a two-body relative orbit analytically (universal variable formulation).
+   * @param x Relative position, updated in place
+   * @param v Relative velocity, updated in place
+   * @param mu Gravitational parameter G * M of the central mass
+   * @param dt Time span
+   */
+  static void keplerDrift(std::array<double, 3> &x, std::array<double, 3> &v, double mu, double dt);
+
+ private:
+  void initialize(Container &particles);
+  void interactionKick(double dt);
+  void centralJump(double dt);
+  void writeBack();
+
+  double delta_t_;
+
+  std::vector<Particle *> bodies_;
+  std::size_t central_{0};
+  double total_mass_{0.0};
+  std::array<double, 3> x_cm_{};
+  std::array<double, 3> v_cm_{};
+  std::vector<std::array<double, 3>> q_;  ///< heliocentric positions
+  std::vector<std::array<double, 3>> u_;  ///< barycentric velocities
+  std::vector<std::array<double, 3>> acc_;
+};
@@ -10,13 +10,21 @@
 #include "Container/ContainerFactory.h"
 #include "Container/ContainerType.h"
 #include "Container/ParticleContainer.h"
+#include "Decomposition/SharedMemoryDecomposition.h"
 #include "Generator/DiscGenerator.h"
 #include "Simulation/SimulationFactory.h"
 #include "inputReader/Arguments.h"
 #include "inputReader/InputReader.h"
 #include "inputReader/SimulationConfig.h"
 #include "inputReader/YamlInputReader.h"
+#include "utils/Affinity.h"
+#include "utils/HugePages.h"
+#include "utils/Parallel.h"
 #include "utils/logging.hpp"
+
+#ifdef MOLSIM_ENABLE_MPI
+#include "Decomposition/MpiTransport.h"
+#endif
 /**
  * @brief Main entry point of the molecular dynamics simulation.
  *
@@ -28,6 +36,9 @@
  * @return EXIT_SUCCESS (0) on successful completion, EXIT_FAILURE on error
  */
 int main(int argc, char *argv[]) {
+#ifdef MOLSIM_ENABLE_MPI
+  const MpiEnvironment mpi(argc, argv);
+#endif
   // Initialize logging (console + simulation.log).
   logging::init_logging();
 
@@ -51,6 +62,28 @@ int main(int argc, char *argv[]) {
     return EXIT_FAILURE;
   }
 
+  // before the first container is created
+  memory::setHugePageMode(cfg.hugePages);
+
+  bool threaded =
+      cfg.subdomains > 1 && cfg.containerType == ContainerType::Cell && cfg.sim_type == SimulationType::Molecule;
+#ifdef MOLSIM_ENABLE_MPI
+  if (threaded && MpiTransport().size() > 1) {
+    SPDLOG_WARN("parallel.subdomains is ignored in a run with several MPI processes.");
+    threaded = false;
+  }
+#endif
+  if (threaded) {
+    SharedMemoryDecomposition::runSimulation(cfg);
+    SPDLOG_INFO("Simulation finished. Output written. Terminating.");
+    return EXIT_SUCCESS;
+  }
+
+  // pinned once, before any parallel region, so the particles are first touched by their pinned threads
+  if (cfg.pinning != PinningPolicy::None) {
+    parallel::pinThreads(cfg.pinning, parallel::resolveThreadCount(cfg.numThreads));
+  }
+
   auto container = ContainerFactory::createContainer(cfg);
   auto &particles = *container;
 
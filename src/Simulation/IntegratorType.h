@@ -0,0 +1,27 @@
+/**
+ * @file IntegratorType.h
+ */
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+/**
+ * Class to differentiate between the different time integration schemes
+ */
+enum class IntegratorType { StormerVerlet, BlockTimeStep, WisdomHolman };
+
+inline auto parseIntegratorType(const std::string &integrator) -> IntegratorType {
+  if (integrator == "StormerVerlet" || integrator == "stormerVerlet" || integrator == "verlet") {
+    return IntegratorType::StormerVerlet;
+  }
+  if (integrator == "BlockTimeStep" || integrator == "blockTimeStep" || integrator == "block") {
+    return IntegratorType::BlockTimeStep;
+  }
+  if (integrator == "WisdomHolman" || integrator == "wisdomHolman" || integrator == "wh") {
+    return IntegratorType::WisdomHolman;
+  }
+  SPDLOG_ERROR("Invalid integrator type: {}", integrator);
+  return IntegratorType::StormerVerlet;
+}
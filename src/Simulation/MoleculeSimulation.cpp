@@ -7,15 +7,21 @@
 
 #include <spdlog/spdlog.h>
 
+#include <array>
 #include <filesystem>
+#include <vector>
 
 #include "Container/ContainerType.h"
 #include "Container/LinkedCellContainer.h"
-#include "ForceCalculation/LennardJones.h"
+#include "Container/ParticleContainer.h"
+#include "Decomposition/DecomposedContainer.h"
+#include "ForceCalculation/ForceCalculationFactory.h"
 #include "Generator/CuboidGenerator.h"
 #include "Generator/DiscGenerator.h"
 #include "Generator/ParticleGenerator.h"
+#include "StepExecutor.h"
 #include "outputWriter/WriterFactory.h"
+#include "utils/ThreadPool.h"
 
 MoleculeSimulation::MoleculeSimulation(const SimulationConfig &cfg, Container &particles)
     : cfg_(cfg), particles_(particles) {}
@@ -36,15 +42,17 @@ void MoleculeSimulation::runSimulation() {
   }
 
   SPDLOG_INFO("Generated {} particles from cuboids.", particles_.size());
+  if (cfg_.containerType == ContainerType::Cell) {
+    // the generators run on one thread, move the particles to the threads that will process them
+    static_cast<LinkedCellContainer *>(&particles_)->distributeStorage();
+  }
 
   // Lennard-Jones force setup
-  LennardJones lj;
-  lj.setEpsilon(5);
-  lj.setSigma(1);
+  const auto lj = ForceCalculationFactory::createForceCalculation(cfg_);
 
   // Initial force evaluation
-  lj.calculateF(particles_);
-  SPDLOG_DEBUG("Initial Lennard-Jones forces computed (epsilon=5, sigma=1).");
+  initialForces(particles_, *lj);
+  SPDLOG_DEBUG("Initial Lennard-Jones forces computed (epsilon={}, sigma={}).", cfg_.epsilon, cfg_.sigma);
 
   // Time integration loop
   double current_time = cfg_.t_start;
@@ -57,39 +65,147 @@ void MoleculeSimulation::runSimulation() {
     static_cast<LinkedCellContainer *>(&particles_)->setBoundaryConditions(cfg_.boundaryConditions);
   }
 
-  while (current_time < cfg_.t_end) {
-    // integrate positions (x), then recompute forces, then velocities (v)
-    LennardJones::calculateX(particles_, cfg_.delta_t);
-    if (cfg_.containerType == ContainerType::Cell) {
-      static_cast<LinkedCellContainer *>(&particles_)->rebuild();
-    }
-    lj.calculateF(particles_);
-    LennardJones::calculateV(particles_, cfg_.delta_t);
+  // The phases of a step as a dependency graph. Output steps copy the particles into one of two snapshots, which is
+  // written while the following steps run; the previous write has always finished before a snapshot is reused.
+  ThreadPool pool(1);
+  StepExecutor executor(pool);
+  std::array<ParticleContainer, 2> snapshots;
+  const auto output_due = [this](int step) { return step % cfg_.write_frequency == 0; };
+  const auto snapshot_of = [&](int step) -> ParticleContainer & {
+    return snapshots[static_cast<std::size_t>(step / cfg_.write_frequency % 2)];
+  };
+  const auto out_name = outputName(particles_);
+
+  std::vector<StepExecutor::PhaseId> before_forces;
+  if (!cfg_.fusedStep) {
+    before_forces.push_back(
+        executor.addPhase("integrate X", [&](int) { ForceCalculation::calculateX(particles_, cfg_.delta_t); }));
+  }
+  // rebinning, ghosts and pair forces, the interior forces overlap the ghost creation
+  const auto forces = executor.addPhase(
+      "forces",
+      [&](int) {
+        if (cfg_.fusedStep) {
+          rebuildWithForces(particles_, *lj, kickDrift(cfg_.delta_t), false);
+        } else {
+          rebuildWithForces(particles_, *lj, [](Particle &) {}, true);
+        }
+      },
+      before_forces);
+  const auto velocities = executor.addPhase(
+      "integrate V", [&](int) { ForceCalculation::calculateV(particles_, cfg_.delta_t); }, {forces});
+  const auto snapshot = executor.addPhase(
+      "snapshot",
+      [&](int step) {
+        if (!output_due(step)) return;
+        if (cfg_.containerType == ContainerType::Cell) {
+          static_cast<LinkedCellContainer *>(&particles_)->deleteHaloCells();
+        }
+        SPDLOG_INFO("Writing output at iteration {} (t = {:.6g}).", step, current_time);
+        auto &copy = snapshot_of(step);
+        copy.clear();
+        copy.reserve(particles_.size());
+        for (const auto &p : particles_) {
+          copy.addParticle(p);
+        }
+      },
+      {velocities});
+  executor.addPhase(
+      "output",
+      [&](int step) {
+        if (output_due(step)) writeParticles(snapshot_of(step), out_name, step, cfg_.output_format);
+      },
+      {snapshot}, true);
 
+  while (current_time < cfg_.t_end) {
     iteration++;
-
-    // Write output every cfg_.write_frequency
-    if (iteration % cfg_.write_frequency == 0) {
-      if (cfg_.containerType == ContainerType::Cell) {
-        static_cast<LinkedCellContainer *>(&particles_)->deleteHaloCells();
-      }
-      SPDLOG_INFO("Writing output at iteration {} (t = {:.6g}).", iteration, current_time);
-      plotParticles(particles_, iteration, cfg_.output_format);
-    }
+    executor.run(iteration);
 
     SPDLOG_DEBUG("Iteration {} finished (t = {}).", iteration, current_time);
 
     current_time += cfg_.delta_t;
   }
+  executor.wait();
 
   SPDLOG_INFO("Molecule simulation completed after {} iterations (final t = {:.6g}).", iteration, current_time);
+
+  if (cfg_.containerType == ContainerType::Cell) {
+    static_cast<LinkedCellContainer *>(&particles_)->getScheduler().logStats();
+  }
+}
+
+void MoleculeSimulation::initialForces(Container &particles, ForceCalculation &force) {
+  if (auto *decomposed = dynamic_cast<DecomposedContainer *>(&particles)) {
+    // migration and halo exchange, so particles near a sub-box face see their partners on the other ranks
+    decomposed->rebuild();
+  }
+  force.calculateF(particles);
+}
+
+void MoleculeSimulation::step(Container &particles, ForceCalculation &force, double delta_t) {
+  ForceCalculation::calculateX(particles, delta_t);
+  rebuildWithForces(particles, force, [](Particle &) {}, true);
+  ForceCalculation::calculateV(particles, delta_t);
+}
+
+void MoleculeSimulation::fusedStep(Container &particles, ForceCalculation &force, double delta_t) {
+  // Sweep A: opening half kick, drift and force reset, binned right away
+  rebuildWithForces(particles, force, kickDrift(delta_t), false);
+
+  // Sweep B: closing half kick with the new forces
+  ForceCalculation::calculateV(particles, delta_t);
+}
+
+auto MoleculeSimulation::kickDrift(double delta_t) -> std::function<void(Particle &)> {
+  return [delta_t](Particle &p) {
+    ForceCalculation::kick(p, delta_t);
+    ForceCalculation::drift(p, delta_t);
+    p.setF({0., 0., 0.});
+  };
+}
+
+void MoleculeSimulation::rebuildWithForces(Container &particles, ForceCalculation &force,
+                                           const std::function<void(Particle &)> &update, bool reset_forces) {
+  auto *linked_cells = dynamic_cast<LinkedCellContainer *>(&particles);
+  const auto pair_force = force.pairForceFunction();
+  if (linked_cells && pair_force) {
+    // the interior pair forces are computed while the ghosts are created
+    if (reset_forces) linked_cells->resetForces();
+    linked_cells->rebuildWithPairForces(update, pair_force);
+    return;
+  }
+
+  if (linked_cells) {
+    linked_cells->rebuild(update);
+  } else {
+    for (auto &p : particles) {
+      update(p);
+    }
+  }
+  if (reset_forces) {
+    force.calculateF(particles);
+  } else {
+    force.addForces(particles);
+  }
 }
 
 void MoleculeSimulation::plotParticles(Container &particles, int iteration, OutputFormat format) {
-  std::filesystem::create_directories("output");
+  writeParticles(particles, outputName(particles), iteration, format);
+}
 
+auto MoleculeSimulation::outputName(const Container &particles) -> std::string {
   // Output file name from Outputformat
   std::string out_name = "output/outputVTK";
+  // every rank of a decomposed run writes its own particles
+  if (const auto *decomposed = dynamic_cast<const DecomposedContainer *>(&particles)) {
+    out_name += "_rank" + std::to_string(decomposed->getDecomposition().getRank());
+  }
+  return out_name;
+}
+
+void MoleculeSimulation::writeParticles(Container &particles, const std::string &out_name, int iteration,
+                                        OutputFormat format) {
+  std::filesystem::create_directories("output");
 
   const auto writer = WriterFactory::createWriter(format);
 
@@ -4,7 +4,11 @@
  */
 #pragma once
 
+#include <functional>
+#include <string>
+
 #include "Container/Container.h"
+#include "ForceCalculation/ForceCalculation.h"
 #include "Generator/DiscGenerator.h"
 #include "Simulation.h"
 #include "inputReader/SimulationConfig.h"
@@ -24,13 +28,53 @@ class MoleculeSimulation : public Simulation {
 
   /**
    * @brief Run the molecular dynamics simulation.
+   *
+   * Every time step runs as a graph of phases on a StepExecutor: integrate X, forces (rebinning, ghosts and pair
+   * forces), integrate V, snapshot and output. The output of a step is written from a snapshot on a pool thread while
+   * the next steps are computed.
    */
   void runSimulation() override;
 
+  /**
+   * @brief The forces at t_start, before the first step.
+   *
+   * A decomposed container is rebuilt first: it exchanges particles with its neighbors only in a rebuild.
+   */
+  static void initialForces(Container &particles, ForceCalculation &force);
+
+  /**
+   * @brief One kick-drift-kick step with separate sweeps: kick and drift, rebinning, force reset, pair forces, kick.
+   *
+   * For a plain pair force on a linked-cell container, rebinning and pair forces run as one task pipeline
+   * (LinkedCellContainer::rebuildWithPairForces): the interior cells do not wait for the ghosts.
+   */
+  static void step(Container &particles, ForceCalculation &force, double delta_t);
+
+  /**
+   * @brief The same step in two particle sweeps.
+   *
+   * Sweep A applies the opening half kick, drifts, zeroes the force and bins each particle right away
+   * (LinkedCellContainer::rebuild, or rebuildWithPairForces together with the pair forces). After the pair forces,
+   * sweep B applies the closing half kick.
+   */
+  static void fusedStep(Container &particles, ForceCalculation &force, double delta_t);
+  /// Sweep A of the fused step for one particle: opening half kick, drift and force reset.
+  static auto kickDrift(double delta_t) -> std::function<void(Particle &)>;
+  /**
+   * @brief Rebin the particles, applying update to each one first, and add the new pair forces.
+   * @param reset_forces Zero the forces first (not needed if update already does)
+   */
+  static void rebuildWithForces(Container &particles, ForceCalculation &force,
+                                const std::function<void(Particle &)> &update, bool reset_forces);
+
   /**
    * @brief Plot Particles using writer classes (VTK, XYZ) for later visualization
    */
   static void plotParticles(Container &particles, int iteration, OutputFormat format);
+  /// Base name of the output files of the given container (with the rank of a decomposed container).
+  static auto outputName(const Container &particles) -> std::string;
+  /// Write the particles to the output files with the given base name.
+  static void writeParticles(Container &particles, const std::string &out_name, int iteration, OutputFormat format);
 
   /// Copy of simulation configuration. This is very cheap!
   SimulationConfig cfg_;
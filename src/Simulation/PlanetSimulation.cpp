@@ -10,6 +10,8 @@
 #include <filesystem>
 
 #include "../ForceCalculation/StormerVerlet.h"
+#include "../Integrator/BlockTimeStepIntegrator.h"
+#include "../Integrator/WisdomHolmanIntegrator.h"
 #include "../outputWriter/WriterFactory.h"
 
 PlanetSimulation::PlanetSimulation(const SimulationConfig &cfg, Container &particles)
@@ -17,6 +19,9 @@ PlanetSimulation::PlanetSimulation(const SimulationConfig &cfg, Container &parti
 
 void PlanetSimulation::runSimulation() {
   // Planet simulation initial condition setup
+  for (const auto &b : cfg_.bodies) {
+    particles_.emplaceParticle(b.position, b.velocity, b.mass, 0);
+  }
 
   if (particles_.empty()) {
     SPDLOG_WARN("PlanetSimulation: No initial particles present! Check YAML configuration.");
@@ -28,11 +33,45 @@ void PlanetSimulation::runSimulation() {
   SPDLOG_INFO("Starting planet simulation: t_start={}, t_end={}, delta_t={}, output every {} steps.", cfg_.t_start,
               cfg_.t_end, cfg_.delta_t, cfg_.write_frequency);
 
+  switch (cfg_.integrator) {
+    case IntegratorType::BlockTimeStep:
+      runBlockTimeStep(current_time, iteration);
+      break;
+    case IntegratorType::WisdomHolman:
+      runWisdomHolman(current_time, iteration);
+      break;
+    default:
+      runStormerVerlet(current_time, iteration);
+      break;
+  }
+
+  SPDLOG_INFO("Planet simulation completed after {} iterations (final t = {:.6g}).", iteration, current_time);
+}
+
+void PlanetSimulation::integrate(double &current_time, int &iteration, const std::function<void()> &step) {
+  while (current_time < cfg_.t_end) {
+    step();
+
+    iteration++;
+
+    if (iteration % cfg_.write_frequency == 0) {
+      SPDLOG_INFO("Writing output at iteration {} (t = {}).", iteration, current_time);
+      plotParticles(particles_, iteration, cfg_.output_format);
+    }
+
+    current_time += cfg_.delta_t;
+  }
+}
+
+void PlanetSimulation::runStormerVerlet(double &current_time, int &iteration) {
   // Time integration loop (Störmer–Verlet)
 
   StormerVerlet verlet;
 
-  while (current_time < cfg_.t_end) {
+  // Initial force evaluation, the first position update already needs F(t_start)
+  verlet.calculateF(particles_);
+
+  integrate(current_time, iteration, [&] {
     // calculate new positions
     StormerVerlet::calculateX(particles_, cfg_.delta_t);
 
@@ -41,19 +80,28 @@ void PlanetSimulation::runSimulation() {
 
     // calculate new velocities
     StormerVerlet::calculateV(particles_, cfg_.delta_t);
+  });
+}
 
-    iteration++;
+void PlanetSimulation::runBlockTimeStep(double &current_time, int &iteration) {
+  // Time integration loop (hierarchical block time steps, delta_t is the largest step)
 
-    if (iteration % cfg_.write_frequency == 0) {
-      SPDLOG_INFO("Writing output at iteration {} (t = {}).", iteration, current_time);
-      plotParticles(particles_, iteration, cfg_.output_format);
-    }
+  BlockTimeStepIntegrator integrator(cfg_.delta_t, cfg_.blockTimeStep.maxLevel, cfg_.blockTimeStep.eta);
 
-    current_time += cfg_.delta_t;
-  }
+  integrate(current_time, iteration, [&] { integrator.step(particles_); });
 
-  SPDLOG_INFO("Planet simulation completed after {} iterations (final t = {:.6g}).", iteration, current_time);
+  SPDLOG_INFO("Block time steps used {} force evaluations ({} with a global step equal to the finest level).",
+              integrator.getForceEvaluations(), integrator.getGlobalStepEvaluations());
+}
+
+void PlanetSimulation::runWisdomHolman(double &current_time, int &iteration) {
+  // Time integration loop (Wisdom-Holman: analytic Kepler drifts around the central body, kicks for perturbations)
+
+  WisdomHolmanIntegrator integrator(cfg_.delta_t);
+
+  integrate(current_time, iteration, [&] { integrator.step(particles_); });
 }
+
 void PlanetSimulation::plotParticles(Container &particles, int iteration, OutputFormat format) {
   std::filesystem::create_directories("output");
 
@@ -4,6 +4,8 @@
  */
 #pragma once
 
+#include <functional>
+
 #include "../Container/ParticleContainer.h"
 #include "../Simulation/Simulation.h"
 #include "../inputReader/Arguments.h"
@@ -30,6 +32,18 @@ class PlanetSimulation : public Simulation {
   void runSimulation() override;
 
  private:
+  /// Advance from current_time to t_end, calling step once per time step and writing output every write_frequency.
+  void integrate(double &current_time, int &iteration, const std::function<void()> &step);
+
+  /// Integrate with a single global time step (Störmer-Verlet).
+  void runStormerVerlet(double &current_time, int &iteration);
+
+  /// Integrate with hierarchical per-body block time steps.
+  void runBlockTimeStep(double &current_time, int &iteration);
+
+  /// Integrate with the Wisdom-Holman mixed-variable symplectic map.
+  void runWisdomHolman(double &current_time, int &iteration);
+
   /**
    * @brief Write particle positions to an output file.
    *
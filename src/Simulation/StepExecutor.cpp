@@ -0,0 +1,126 @@
+#include "StepExecutor.h"
+
+#include <stdexcept>
+
+StepExecutor::~StepExecutor() {
+  for (auto &phase : phases) {
+    if (phase.pending.valid()) phase.pending.wait();
+  }
+}
+
+auto StepExecutor::addPhase(std::string name, Body body, const std::vector<PhaseId> &dependencies,
+                            bool overlaps_next_step) -> PhaseId {
+  const PhaseId id = phases.size();
+  for (const auto dependency : dependencies) {
+    if (dependency >= id) {
+      throw std::invalid_argument("Phase '" + name + "' depends on an unknown phase");
+    }
+    if (phases[dependency].overlaps_next_step) {
+      throw std::invalid_argument("Phase '" + name + "' depends on '" + phases[dependency].name +
+                                  "', which overlaps the next step");
+    }
+  }
+
+  Phase phase;
+  phase.name = std::move(name);
+  phase.body = std::move(body);
+  phase.num_dependencies = dependencies.size();
+  phase.overlaps_next_step = overlaps_next_step;
+  phases.push_back(std::move(phase));
+  for (const auto dependency : dependencies) {
+    phases[dependency].successors.push_back(id);
+  }
+  return id;
+}
+
+void StepExecutor::complete(PhaseId id, std::exception_ptr error) {
+  ++completed;
+  if (error && !step_error) step_error = error;
+  for (const auto successor : phases[id].successors) {
+    if (--missing[successor] == 0) ready.push_back(successor);
+  }
+}
+
+void StepExecutor::run(int step) {
+  std::unique_lock<std::mutex> guard(lock);
+  missing.resize(phases.size());
+  ready.clear();
+  for (PhaseId id = 0; id < phases.size(); ++id) {
+    missing[id] = phases[id].num_dependencies;
+    if (missing[id] == 0) ready.push_back(id);
+  }
+  completed = 0;
+  step_error = nullptr;
+
+  std::vector<PhaseId> batch;
+  while (completed < phases.size()) {
+    finished.wait(guard, [this] { return !ready.empty() || completed == phases.size(); });
+    batch.swap(ready);
+    ready.clear();
+
+    // overlapping phases and all but one of the other ready phases go to the pool
+    PhaseId inline_phase = phases.size();
+    for (const auto id : batch) {
+      auto &phase = phases[id];
+      if (step_error) {
+        complete(id, nullptr);  // nothing new starts after a failure
+      } else if (phase.overlaps_next_step) {
+        std::exception_ptr error;
+        if (phase.pending.valid()) {
+          // the previous instance must be done before the next one starts
+          guard.unlock();
+          try {
+            phase.pending.get();
+          } catch (...) {
+            error = std::current_exception();
+          }
+          guard.lock();
+        }
+        if (!error) phase.pending = pool.submit([&phase, step] { phase.body(step); });
+        complete(id, error);
+      } else if (inline_phase == phases.size()) {
+        inline_phase = id;
+      } else {
+        pool.submit([this, id, step] {
+          std::exception_ptr error;
+          try {
+            phases[id].body(step);
+          } catch (...) {
+            error = std::current_exception();
+          }
+          const std::lock_guard<std::mutex> done(lock);
+          complete(id, error);
+          finished.notify_one();
+        });
+      }
+    }
+    batch.clear();
+
+    if (inline_phase < phases.size()) {
+      guard.unlock();
+      std::exception_ptr error;
+      try {
+        phases[inline_phase].body(step);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      guard.lock();
+      complete(inline_phase, error);
+    }
+  }
+
+  if (step_error) std::rethrow_exception(step_error);
+}
+
+void StepExecutor::wait() {
+  std::exception_ptr error;
+  for (auto &phase : phases) {
+    if (!phase.pending.valid()) continue;
+    try {
+      phase.pending.get();
+    } catch (...) {
+      if (!error) error = std::current_exception();
+    }
+  }
+  if (error) std::rethrow_exception(error);
+}
@@ -0,0 +1,86 @@
+/**
+ * @file StepExecutor.h
+ * @brief Runs the phases of a time step as a dependency graph on a persistent thread pool.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "utils/ThreadPool.h"
+
+/**
+ * @brief Dependency graph of the phases of one time step.
+ *
+ * Phases are added once, before the first run(), with the phases they depend on. These must have been added before,
+ * so the graph is acyclic by construction. run() executes one step: a phase starts as soon as all its dependencies of the same step have
+ * finished. The calling thread runs one ready phase itself, further phases that are ready at the same time go to the
+ * pool, so a chain of phases stays on the calling thread (and its OpenMP team).
+ *
+ * A phase added with overlaps_next_step runs on the pool and may still be running when run() returns, i.e. while
+ * the next step is computed (e.g. writing a snapshot of step n while the forces of step n + 1 are computed). Such a
+ * phase cannot be a dependency; its next instance waits for the previous one, and wait() waits for the last.
+ */
+class StepExecutor {
+ public:
+  using PhaseId = std::size_t;
+  using Body = std::function<void(int step)>;
+
+  explicit StepExecutor(ThreadPool &pool) : pool(pool) {}
+  /// Waits for phases still running from the last step; their exceptions are dropped.
+  ~StepExecutor();
+  StepExecutor(const StepExecutor &) = delete;
+  StepExecutor &operator=(const StepExecutor &) = delete;
+
+  /**
+   * @brief Add a phase to the graph.
+   * @param name Name used in error messages
+   * @param body Called with the number of the step
+   * @param dependencies Phases of the same step that must have finished first
+   * @param overlaps_next_step Whether run() may return before this phase has finished
+   * @return Id to use as a dependency of later phases
+   * @throws std::invalid_argument if a dependency is unknown or overlaps the next step
+   */
+  auto addPhase(std::string name, Body body, const std::vector<PhaseId> &dependencies = {},
+                bool overlaps_next_step = false) -> PhaseId;
+  /**
+   * @brief Execute all phases of one step.
+   *
+   * Rethrows the first exception of a phase after all phases started in this step have finished; phases that would
+   * start after a failure are skipped.
+   */
+  void run(int step);
+  /// Wait for the phases that overlap the next step; rethrows their first exception.
+  void wait();
+  [[nodiscard]] auto numPhases() const noexcept -> std::size_t { return phases.size(); }
+
+ private:
+  struct Phase {
+    std::string name;
+    Body body;
+    std::vector<PhaseId> successors;
+    std::size_t num_dependencies = 0;
+    bool overlaps_next_step = false;
+    std::future<void> pending;  ///< Last instance of an overlapping phase.
+  };
+
+  /// Mark a phase of the current step as finished and release its successors (lock held).
+  void complete(PhaseId id, std::exception_ptr error);
+
+  ThreadPool &pool;
+  std::vector<Phase> phases;
+
+  // state of the running step
+  std::mutex lock;
+  std::condition_variable finished;
+  std::vector<std::size_t> missing;  ///< Unfinished dependencies of every phase.
+  std::vector<PhaseId> ready;
+  std::size_t completed = 0;
+  std::exception_ptr step_error;
+};
@@ -10,9 +10,14 @@
 
 #include "Container/ContainerType.h"
 #include "Container/LinkedCellContainer.h"
+#include "Container/ParallelStrategy.h"
 #include "Cuboid.h"
+#include "ForceCalculation/ForceType.h"
+#include "Simulation/IntegratorType.h"
 #include "Simulation/SimulationType.h"
 #include "outputWriter/OutputFormat.h"
+#include "utils/Affinity.h"
+#include "utils/HugePages.h"
 
 /// Disc definition
 struct Disc {
@@ -24,6 +29,38 @@ struct Disc {
   int typeDisc = 0;                      // particle type
 };
 
+/// Celestial body definition (planet simulations)
+struct Body {
+  std::array<double, 3> position{};  // [x,y,z]
+  std::array<double, 3> velocity{};  // [vx,vy,vz]
+  double mass = 1.0;                 // body mass
+};
+
+/// Parameters of the hierarchical block time step integrator
+struct BlockTimeStepConfig {
+  int maxLevel = 10;  // finest step is delta_t / 2^maxLevel
+  double eta = 0.02;  // accuracy parameter scaling the per-body time scale
+};
+
+/// Lennard-Jones parameters of one particle type (multi-species molecule simulations)
+struct ParticleType {
+  int type = 0;          // type id used by cuboids and discs
+  double epsilon = 5.0;  // well depth
+  double sigma = 1.0;    // zero crossing
+};
+
+/// Parameters of a tabulated pair potential (force_type: Tabulated)
+struct TabulatedConfig {
+  TabulatedPotentialType potential = TabulatedPotentialType::LennardJones;
+  int points = 4096;                 // grid points in r^2
+  double rMin = 0.5;                 // smallest tabulated distance
+  double morseDepth = 1.0;           // Morse well depth D
+  double morseWidth = 1.0;           // Morse width parameter a
+  double morseR0 = 1.0;              // Morse equilibrium distance
+  double softSphereExponent = 12.0;  // soft-sphere exponent n
+  std::string file;                  // user table with the columns "r U F"
+};
+
 /**
  * @brief Bundles all simulation configuration options.
  */
@@ -33,6 +70,11 @@ struct SimulationConfig {
   double t_start = 0.0;
   double t_end = 1000.0;
   double delta_t = 0.014;
+  IntegratorType integrator = IntegratorType::StormerVerlet;
+  ForceType forceType = ForceType::TruncatedShiftedLennardJones;
+  double epsilon = 5.0;     // Lennard-Jones well depth
+  double sigma = 1.0;       // Lennard-Jones zero crossing
+  bool fusedStep = false;  // fuse integration, binning and force reset into two particle sweeps per step
 
 #ifdef ENABLE_VTK_OUTPUT
   OutputFormat output_format = OutputFormat::VTK;
@@ -48,6 +90,29 @@ struct SimulationConfig {
   // --- Discs
   std::vector<Disc> discs;
 
+  // --- Bodies (planet simulations)
+  std::vector<Body> bodies;
+
+  // --- Block time steps (planet simulations)
+  BlockTimeStepConfig blockTimeStep;
+
+  // --- Per-type Lennard-Jones parameters (molecule simulations)
+  std::vector<ParticleType> particleTypes;
+
+  // --- Tabulated pair potential (molecule simulations)
+  TabulatedConfig tabulated;
+
+  // --- Parallelization
+  int numThreads = 0;  // OpenMP threads of the linked-cell traversal, 0 = OpenMP default
+  ParallelStrategy parallelStrategy = ParallelStrategy::Coloring;  // force accumulation on several threads
+  CellSchedule cellSchedule = CellSchedule::Dynamic;               // distribution of the cells of a color
+  CellTraversal cellTraversal = CellTraversal::HalfShell;          // cell pairs of one traversal task
+  int prefetchDistance = 0;  // software prefetch lookahead of the traversal in cell pairs, 0 = off
+  std::array<int, 3> rankDims{0, 0, 0};  // MPI sub-boxes per dimension, 0 = chosen automatically
+  int subdomains = 0;                     // threads of a shared-memory decomposition, <= 1 = off
+  PinningPolicy pinning = PinningPolicy::None;  // placement of the OpenMP threads on the cores
+  HugePageMode hugePages = HugePageMode::None;  // backing of the large particle and cell arrays
+
   ContainerType containerType = ContainerType::Cell;  // containerType where all
 
   double rCutoff = 0.0;  // cutoff radius
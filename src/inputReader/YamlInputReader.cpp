@@ -54,6 +54,31 @@ SimulationConfig YamlInputReader::parse() const {
     parseDiscsSection(root["discs"], cfg);
   }
 
+  // --- bodies section (optional) ---
+  if (root["bodies"]) {
+    parseBodiesSection(root["bodies"], cfg);
+  }
+
+  // --- block time step section (optional) ---
+  if (root["blockTimeStep"]) {
+    parseBlockTimeStepSection(root["blockTimeStep"], cfg);
+  }
+
+  // --- particle types section (optional) ---
+  if (root["particleTypes"]) {
+    parseParticleTypesSection(root["particleTypes"], cfg);
+  }
+
+  // --- tabulated potential section (optional) ---
+  if (root["tabulated"]) {
+    parseTabulatedSection(root["tabulated"], cfg);
+  }
+
+  // --- parallel section (optional) ---
+  if (root["parallel"]) {
+    parseParallelSection(root["parallel"], cfg);
+  }
+
   // --- linked cell section (optional) ---
   if (root["linkedCell"]) {
     parseLinkedCellSection(root["linkedCell"], cfg);
@@ -84,12 +109,31 @@ void YamlInputReader::parseSimulationSection(const YAML::Node &n, SimulationConf
   cfg.delta_t = n["delta_t"].as<double>();
   cfg.output_format = parse_output(formatStr);
 
+  if (n["integrator"]) {
+    cfg.integrator = parseIntegratorType(n["integrator"].as<std::string>());
+  }
+  if (n["force_type"]) {
+    cfg.forceType = parseForceType(n["force_type"].as<std::string>());
+  }
+  if (n["fused_step"]) {
+    cfg.fusedStep = n["fused_step"].as<bool>();
+  }
+  if (n["epsilon"]) {
+    cfg.epsilon = n["epsilon"].as<double>();
+  }
+  if (n["sigma"]) {
+    cfg.sigma = n["sigma"].as<double>();
+  }
+
   if (cfg.t_start > cfg.t_end) {
     throw std::runtime_error("YAML error: simulation.t_start must be <= simulation.t_end");
   }
   if (cfg.delta_t <= 0.0) {
     throw std::runtime_error("YAML error: simulation.delta_t must be > 0");
   }
+  if (cfg.epsilon <= 0.0 || cfg.sigma <= 0.0) {
+    throw std::runtime_error("YAML error: simulation.epsilon and simulation.sigma must be > 0");
+  }
 }
 
 // Parsing of output Section
@@ -176,6 +220,155 @@ void YamlInputReader::parseDiscsSection(const YAML::Node &n, SimulationConfig &c
     cfg.discs.push_back(d);
   }
 }
+// Parsing Bodies section
+
+void YamlInputReader::parseBodiesSection(const YAML::Node &n, SimulationConfig &cfg) const {
+  if (!n.IsSequence()) throw std::runtime_error("YAML error: 'bodies' must be a sequence");
+
+  for (const auto &node : n) {
+    Body b;
+
+    b.position = parseVec3(node["position"], "position");
+    b.velocity = parseVec3(node["velocity"], "velocity");
+
+    if (!node["mass"]) {
+      throw std::runtime_error("YAML error: body.mass is required");
+    }
+    b.mass = node["mass"].as<double>();
+
+    cfg.bodies.push_back(b);
+  }
+}
+
+// Parsing Block time step section
+
+void YamlInputReader::parseBlockTimeStepSection(const YAML::Node &n, SimulationConfig &cfg) const {
+  if (n["maxLevel"]) {
+    cfg.blockTimeStep.maxLevel = n["maxLevel"].as<int>();
+  }
+  if (n["eta"]) {
+    cfg.blockTimeStep.eta = n["eta"].as<double>();
+  }
+
+  if (cfg.blockTimeStep.maxLevel < 0 || cfg.blockTimeStep.maxLevel > 30) {
+    throw std::runtime_error("YAML error: blockTimeStep.maxLevel must be in [0, 30]");
+  }
+  if (cfg.blockTimeStep.eta <= 0.0) {
+    throw std::runtime_error("YAML error: blockTimeStep.eta must be > 0");
+  }
+}
+
+// Parsing Particle types section
+
+void YamlInputReader::parseParticleTypesSection(const YAML::Node &n, SimulationConfig &cfg) const {
+  if (!n.IsSequence()) throw std::runtime_error("YAML error: 'particleTypes' must be a sequence");
+
+  for (const auto &node : n) {
+    if (!node["type"] || !node["epsilon"] || !node["sigma"]) {
+      throw std::runtime_error("YAML error: particleTypes entries need type, epsilon and sigma");
+    }
+    ParticleType t;
+    t.type = node["type"].as<int>();
+    t.epsilon = node["epsilon"].as<double>();
+    t.sigma = node["sigma"].as<double>();
+
+    if (t.type < 0) {
+      throw std::runtime_error("YAML error: particleTypes.type must be >= 0");
+    }
+    if (t.epsilon <= 0.0 || t.sigma <= 0.0) {
+      throw std::runtime_error("YAML error: particleTypes.epsilon and sigma must be > 0");
+    }
+    cfg.particleTypes.push_back(t);
+  }
+}
+
+// Parsing Tabulated potential section
+
+void YamlInputReader::parseTabulatedSection(const YAML::Node &n, SimulationConfig &cfg) const {
+  auto &t = cfg.tabulated;
+  if (n["potential"]) {
+    t.potential = parseTabulatedPotentialType(n["potential"].as<std::string>());
+  }
+  if (n["points"]) {
+    t.points = n["points"].as<int>();
+  }
+  if (n["rMin"]) {
+    t.rMin = n["rMin"].as<double>();
+  }
+  if (n["morseDepth"]) {
+    t.morseDepth = n["morseDepth"].as<double>();
+  }
+  if (n["morseWidth"]) {
+    t.morseWidth = n["morseWidth"].as<double>();
+  }
+  if (n["morseR0"]) {
+    t.morseR0 = n["morseR0"].as<double>();
+  }
+  if (n["softSphereExponent"]) {
+    t.softSphereExponent = n["softSphereExponent"].as<double>();
+  }
+  if (n["file"]) {
+    t.file = n["file"].as<std::string>();
+  }
+
+  if (t.points < 2) {
+    throw std::runtime_error("YAML error: tabulated.points must be >= 2");
+  }
+  if (t.rMin <= 0.0) {
+    throw std::runtime_error("YAML error: tabulated.rMin must be > 0");
+  }
+  if (t.potential == TabulatedPotentialType::File && t.file.empty()) {
+    throw std::runtime_error("YAML error: tabulated.file is required for potential 'File'");
+  }
+}
+
+// Parsing Parallel section
+
+void YamlInputReader::parseParallelSection(const YAML::Node &n, SimulationConfig &cfg) const {
+  if (n["threads"]) {
+    cfg.numThreads = n["threads"].as<int>();
+  }
+  if (n["strategy"]) {
+    cfg.parallelStrategy = parseParallelStrategy(n["strategy"].as<std::string>());
+  }
+  if (n["schedule"]) {
+    cfg.cellSchedule = parseCellSchedule(n["schedule"].as<std::string>());
+  }
+  if (n["traversal"]) {
+    cfg.cellTraversal = parseCellTraversal(n["traversal"].as<std::string>());
+  }
+  if (n["prefetch"]) {
+    cfg.prefetchDistance = n["prefetch"].as<int>();
+  }
+  if (n["ranks"]) {
+    cfg.rankDims = parseVec3Int(n["ranks"], "parallel.ranks");
+  }
+  if (n["subdomains"]) {
+    cfg.subdomains = n["subdomains"].as<int>();
+  }
+  if (n["pinning"]) {
+    cfg.pinning = parsePinningPolicy(n["pinning"].as<std::string>());
+  }
+  if (n["hugePages"]) {
+    cfg.hugePages = parseHugePageMode(n["hugePages"].as<std::string>());
+  }
+
+  if (cfg.numThreads < 0) {
+    throw std::runtime_error("YAML error: parallel.threads must be >= 0");
+  }
+  for (const int d : cfg.rankDims) {
+    if (d < 0) {
+      throw std::runtime_error("YAML error: parallel.ranks must be >= 0");
+    }
+  }
+  if (cfg.prefetchDistance < 0) {
+    throw std::runtime_error("YAML error: parallel.prefetch must be >= 0");
+  }
+  if (cfg.subdomains < 0) {
+    throw std::runtime_error("YAML error: parallel.subdomains must be >= 0");
+  }
+}
+
 // Parsing Linked Cell section
 
 void YamlInputReader::parseLinkedCellSection(const YAML::Node &n, SimulationConfig &cfg) const {
@@ -56,6 +56,21 @@ class YamlInputReader {
   /// parse Disc section in YAML file
   void parseDiscsSection(const YAML::Node &node, SimulationConfig &cfg) const;
 
+  /// parse Bodies section (planet simulations) in YAML file
+  void parseBodiesSection(const YAML::Node &node, SimulationConfig &cfg) const;
+
+  /// parse BlockTimeStep section in YAML file
+  void parseBlockTimeStepSection(const YAML::Node &node, SimulationConfig &cfg) const;
+
+  /// parse ParticleTypes section in YAML file
+  void parseParticleTypesSection(const YAML::Node &node, SimulationConfig &cfg) const;
+
+  /// parse Tabulated potential section in YAML file
+  void parseTabulatedSection(const YAML::Node &node, SimulationConfig &cfg) const;
+
+  /// parse Parallel section in YAML file
+  void parseParallelSection(const YAML::Node &node, SimulationConfig &cfg) const;
+
   /// parse LinkedCell section in YAML file
   void parseLinkedCellSection(const YAML::Node &node, SimulationConfig &cfg) const;
 
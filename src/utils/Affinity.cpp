@@ -0,0 +1,142 @@
+#include "Affinity.h"
+
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <mutex>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace parallel {
+
+namespace {
+int readTopologyValue(int cpu, const std::string &name, int fallback) {
+  std::ifstream file("/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name);
+  int value = fallback;
+  if (file >> value) return value;
+  return fallback;
+}
+
+#ifdef __linux__
+std::mutex process_cpus_lock;
+cpu_set_t process_cpus;  ///< Mask of the first thread that pinned itself, taken before any thread was pinned.
+bool has_process_cpus = false;
+
+void saveProcessCpus() {
+  const std::lock_guard<std::mutex> guard(process_cpus_lock);
+  if (has_process_cpus) return;
+  CPU_ZERO(&process_cpus);
+  has_process_cpus = sched_getaffinity(0, sizeof(process_cpus), &process_cpus) == 0;
+}
+#endif
+}  // namespace
+
+auto pinningOrder(PinningPolicy policy, const std::vector<CpuLocation> &cpus) -> std::vector<int> {
+  if (policy == PinningPolicy::None || cpus.empty()) return {};
+
+  // hardware threads of every (package, core), in CPU order
+  std::map<std::pair<int, int>, std::vector<int>> cores;
+  for (const auto &c : cpus) {
+    cores[{c.package, c.core}].push_back(c.cpu);
+  }
+  std::size_t max_siblings = 0;
+  for (auto &[key, siblings] : cores) {
+    std::sort(siblings.begin(), siblings.end());
+    max_siblings = std::max(max_siblings, siblings.size());
+  }
+
+  std::vector<int> order;
+  order.reserve(cpus.size());
+  for (std::size_t sibling = 0; sibling < max_siblings; ++sibling) {
+    // the sibling-th hardware thread of every core, grouped by package
+    std::map<int, std::vector<int>> packages;
+    for (const auto &[key, siblings] : cores) {
+      if (sibling < siblings.size()) packages[key.first].push_back(siblings[sibling]);
+    }
+    if (policy == PinningPolicy::Compact) {
+      for (const auto &[package, package_cpus] : packages) {
+        order.insert(order.end(), package_cpus.begin(), package_cpus.end());
+      }
+      continue;
+    }
+    for (std::size_t round = 0;; ++round) {
+      bool placed = false;
+      for (const auto &[package, package_cpus] : packages) {
+        if (round < package_cpus.size()) {
+          order.push_back(package_cpus[round]);
+          placed = true;
+        }
+      }
+      if (!placed) break;
+    }
+  }
+  return order;
+}
+
+auto availableCpus() -> std::vector<CpuLocation> {
+  std::vector<CpuLocation> cpus;
+#ifdef __linux__
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0) return cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+    if (!CPU_ISSET(cpu, &allowed)) continue;
+    cpus.push_back({cpu, readTopologyValue(cpu, "physical_package_id", 0), readTopologyValue(cpu, "core_id", cpu)});
+  }
+#endif
+  return cpus;
+}
+
+auto pinCurrentThread(int cpu) -> bool {
+#ifdef __linux__
+  saveProcessCpus();
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+  (void)cpu;
+  return false;
+#endif
+}
+
+void unpinCurrentThread() {
+#ifdef __linux__
+  cpu_set_t cpus;
+  {
+    const std::lock_guard<std::mutex> guard(process_cpus_lock);
+    if (!has_process_cpus) return;
+    cpus = process_cpus;
+  }
+  sched_setaffinity(0, sizeof(cpus), &cpus);
+#endif
+}
+
+auto pinThreads(PinningPolicy policy, int threads) -> int {
+  const auto order = pinningOrder(policy, availableCpus());
+  if (order.empty()) return 0;
+  threads = std::max(1, threads);
+  if (static_cast<std::size_t>(threads) > order.size()) {
+    SPDLOG_WARN("{} threads on {} CPUs: several threads share a CPU.", threads, order.size());
+  }
+
+  int pinned = 0;
+#ifdef _OPENMP
+#pragma omp parallel num_threads(threads) reduction(+ : pinned)
+  pinned += pinCurrentThread(order[static_cast<std::size_t>(omp_get_thread_num()) % order.size()]) ? 1 : 0;
+#else
+  // without OpenMP the calling thread is the only one
+  pinned = pinCurrentThread(order.front()) ? 1 : 0;
+#endif
+  SPDLOG_INFO("Pinned {} of {} threads ({}).", pinned, threads,
+              policy == PinningPolicy::Compact ? "compact" : "scatter");
+  return pinned;
+}
+
+}  // namespace parallel
@@ -0,0 +1,78 @@
+/**
+ * @file Affinity.h
+ * @brief Pinning of the OpenMP threads to cores.
+ */
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+#include <vector>
+
+/**
+ * Class to differentiate between the ways the OpenMP threads are pinned to cores
+ *
+ * Compact fills the cores of one socket before the next one, so neighboring threads share caches; Scatter deals the
+ * threads out round-robin over the sockets, so every socket contributes its memory bandwidth. Hardware threads of a
+ * core are only used once every core has a thread. None leaves the placement to the operating system.
+ */
+enum class PinningPolicy { None, Compact, Scatter };
+
+inline auto parsePinningPolicy(const std::string &policy) -> PinningPolicy {
+  if (policy == "None" || policy == "none") {
+    return PinningPolicy::None;
+  }
+  if (policy == "Compact" || policy == "compact") {
+    return PinningPolicy::Compact;
+  }
+  if (policy == "Scatter" || policy == "scatter") {
+    return PinningPolicy::Scatter;
+  }
+  SPDLOG_ERROR("Invalid pinning policy: {}", policy);
+  return PinningPolicy::None;
+}
+
+namespace parallel {
+
+/// Location of a logical CPU in the machine.
+struct CpuLocation {
+  int cpu = 0;      ///< Logical CPU number.
+  int package = 0;  ///< Socket.
+  int core = 0;     ///< Core within the socket.
+};
+
+/**
+ * @brief CPUs for threads 0, 1, 2, ... according to the policy.
+ *
+ * Pure function of the topology, so it can be tested without the machine: the first hardware thread of every core is
+ * listed before the second ones, within that compact orders by (package, core) and scatter takes one core of every
+ * package in turn. Thread i uses entry i modulo the size.
+ * @param policy Compact or Scatter (None returns an empty list)
+ * @param cpus CPUs the process may run on
+ */
+auto pinningOrder(PinningPolicy policy, const std::vector<CpuLocation> &cpus) -> std::vector<int>;
+
+/// CPUs the process may run on with their package and core (Linux sysfs), empty where this is unknown.
+auto availableCpus() -> std::vector<CpuLocation>;
+
+/// Restrict the calling thread to one CPU; false off Linux or if the CPU is not available.
+auto pinCurrentThread(int cpu) -> bool;
+
+/**
+ * @brief Let the calling thread run on all CPUs the process had before the first pinning.
+ *
+ * A new thread inherits the mask of the thread that starts it, so helper threads started by a pinned thread (the
+ * output worker of the step) would share its single CPU. Nothing happens if no thread was pinned yet.
+ */
+void unpinCurrentThread();
+
+/**
+ * @brief Pin the threads of the OpenMP team of the given size, and with it the calling thread as thread 0.
+ *
+ * The OpenMP runtime keeps the threads of a team for later parallel regions of the same size, so this is done once,
+ * before the first force computation. Without OpenMP, off Linux or with None nothing happens.
+ * @return Number of threads pinned
+ */
+auto pinThreads(PinningPolicy policy, int threads) -> int;
+
+}  // namespace parallel
@@ -0,0 +1,121 @@
+#include "HugePages.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace memory {
+
+namespace {
+std::atomic<HugePageMode> current_mode{HugePageMode::None};
+
+struct Mapping {
+  std::size_t bytes;
+  bool explicit_pages;
+};
+
+/// Mappings handed out by allocate(), by address.
+std::mutex mappings_lock;
+std::unordered_map<void *, Mapping> mappings;
+HugePageStats stats;
+
+auto roundUp(std::size_t bytes) -> std::size_t { return (bytes + hugePageSize - 1) / hugePageSize * hugePageSize; }
+
+#ifdef __linux__
+/// A 2 MiB aligned anonymous mapping advised for transparent huge pages.
+auto mapTransparent(std::size_t bytes) -> void * {
+  // over-allocate by one huge page and trim both ends to the alignment
+  const auto reserved = bytes + hugePageSize;
+  void *raw = mmap(nullptr, reserved, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (raw == MAP_FAILED) return nullptr;
+  const auto address = reinterpret_cast<std::uintptr_t>(raw);
+  const auto aligned = (address + hugePageSize - 1) / hugePageSize * hugePageSize;
+  if (aligned > address) munmap(raw, aligned - address);
+  const auto tail = address + reserved - (aligned + bytes);
+  if (tail > 0) munmap(reinterpret_cast<void *>(aligned + bytes), tail);
+
+  auto *pointer = reinterpret_cast<void *>(aligned);
+  madvise(pointer, bytes, MADV_HUGEPAGE);  // without THP support the mapping just stays on small pages
+  return pointer;
+}
+#endif
+}  // namespace
+
+void setHugePageMode(HugePageMode mode) { current_mode = mode; }
+
+auto hugePageMode() -> HugePageMode { return current_mode; }
+
+auto hugePageStats() -> HugePageStats {
+  const std::lock_guard<std::mutex> guard(mappings_lock);
+  return stats;
+}
+
+auto allocate(std::size_t bytes) -> void * {
+#ifdef __linux__
+  const auto mode = current_mode.load();
+  if (mode != HugePageMode::None && bytes >= hugePageSize) {
+    const auto mapped = roundUp(bytes);
+    void *pointer = nullptr;
+    bool explicit_pages = false;
+    if (mode == HugePageMode::Explicit) {
+      pointer = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (pointer == MAP_FAILED) {
+        SPDLOG_DEBUG("No {} bytes in the hugetlbfs pool, using transparent huge pages.", mapped);
+        pointer = nullptr;
+      } else {
+        explicit_pages = true;
+      }
+    }
+    if (!pointer) pointer = mapTransparent(mapped);
+    if (pointer) {
+      const std::lock_guard<std::mutex> guard(mappings_lock);
+      mappings.emplace(pointer, Mapping{mapped, explicit_pages});
+      (explicit_pages ? stats.explicitBytes : stats.transparentBytes) += mapped;
+      return pointer;
+    }
+  }
+#endif
+  return ::operator new(bytes);
+}
+
+void deallocate(void *pointer, std::size_t bytes) noexcept {
+#ifdef __linux__
+  if (bytes >= hugePageSize) {
+    std::unique_lock<std::mutex> guard(mappings_lock);
+    const auto it = mappings.find(pointer);
+    if (it != mappings.end()) {
+      const auto mapping = it->second;
+      mappings.erase(it);
+      (mapping.explicit_pages ? stats.explicitBytes : stats.transparentBytes) -= mapping.bytes;
+      guard.unlock();
+      munmap(pointer, mapping.bytes);
+      return;
+    }
+  }
+#endif
+  (void)bytes;
+  ::operator delete(pointer);
+}
+
+auto adviseHugePages(const void *begin, std::size_t bytes) -> bool {
+#ifdef __linux__
+  const auto first = (reinterpret_cast<std::uintptr_t>(begin) + hugePageSize - 1) / hugePageSize * hugePageSize;
+  const auto last = (reinterpret_cast<std::uintptr_t>(begin) + bytes) / hugePageSize * hugePageSize;
+  if (last <= first) return false;
+  // ranges with unmapped gaps report ENOMEM, the mapped parts are advised anyway
+  const int result = madvise(reinterpret_cast<void *>(first), last - first, MADV_HUGEPAGE);
+  return result == 0 || errno == ENOMEM;
+#else
+  (void)begin;
+  (void)bytes;
+  return false;
+#endif
+}
+
+}  // namespace memory
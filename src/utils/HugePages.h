@@ -0,0 +1,103 @@
+/**
+ * @file HugePages.h
+ * @brief Huge-page backing for the large particle and cell arrays.
+ */
+#pragma once
+
+#include <spdlog/spdlog.h>
+
+#include <cstddef>
+#include <new>
+#include <string>
+#include <vector>
+
+/**
+ * Class to differentiate between the ways large arrays are backed by huge pages
+ *
+ * Transparent maps large arrays 2 MiB aligned and advises the kernel to use transparent huge pages
+ * (madvise(MADV_HUGEPAGE)); Explicit maps them from the reserved hugetlbfs pool (MAP_HUGETLB) and falls back to
+ * Transparent when the pool is exhausted. None uses the default allocator.
+ */
+enum class HugePageMode { None, Transparent, Explicit };
+
+inline auto parseHugePageMode(const std::string &mode) -> HugePageMode {
+  if (mode == "None" || mode == "none") {
+    return HugePageMode::None;
+  }
+  if (mode == "Transparent" || mode == "transparent") {
+    return HugePageMode::Transparent;
+  }
+  if (mode == "Explicit" || mode == "explicit") {
+    return HugePageMode::Explicit;
+  }
+  SPDLOG_ERROR("Invalid huge page mode: {}", mode);
+  return HugePageMode::None;
+}
+
+namespace memory {
+
+/// Size of a huge page; smaller allocations always use the default allocator.
+inline constexpr std::size_t hugePageSize = std::size_t{2} << 20;
+
+/// Mode used by later allocations of HugePageAllocator (default None); set once at start-up.
+void setHugePageMode(HugePageMode mode);
+[[nodiscard]] auto hugePageMode() -> HugePageMode;
+
+/// Bytes currently mapped from hugetlbfs and bytes currently advised for transparent huge pages.
+struct HugePageStats {
+  std::size_t explicitBytes = 0;
+  std::size_t transparentBytes = 0;
+};
+[[nodiscard]] auto hugePageStats() -> HugePageStats;
+
+/**
+ * @brief Allocate bytes, huge-page backed if the mode asks for it and the size reaches hugePageSize.
+ *
+ * Falls back to the default allocator if the mapping fails; throws std::bad_alloc only if that fails as well.
+ */
+[[nodiscard]] auto allocate(std::size_t bytes) -> void *;
+/// Release memory of allocate(), whichever way it was obtained.
+void deallocate(void *pointer, std::size_t bytes) noexcept;
+/**
+ * @brief Advise transparent huge pages for the whole 2 MiB pages inside [begin, begin + bytes).
+ *
+ * For memory that is not owned by allocate(), e.g. the individually allocated particles of a malloc arena.
+ * @return False if the range holds no whole huge page or the kernel rejected the advice
+ */
+auto adviseHugePages(const void *begin, std::size_t bytes) -> bool;
+
+}  // namespace memory
+
+/**
+ * @brief Standard allocator that backs allocations of at least one huge page according to memory::hugePageMode().
+ *
+ * Stateless, so containers using it can be swapped and moved like with std::allocator.
+ */
+template <typename T>
+class HugePageAllocator {
+ public:
+  using value_type = T;
+
+  HugePageAllocator() noexcept = default;
+  template <typename U>
+  HugePageAllocator(const HugePageAllocator<U> & /*other*/) noexcept {}
+
+  [[nodiscard]] auto allocate(std::size_t n) -> T * {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned types are not supported");
+    return static_cast<T *>(memory::allocate(n * sizeof(T)));
+  }
+  void deallocate(T *pointer, std::size_t n) noexcept { memory::deallocate(pointer, n * sizeof(T)); }
+
+  template <typename U>
+  auto operator==(const HugePageAllocator<U> & /*other*/) const noexcept -> bool {
+    return true;
+  }
+  template <typename U>
+  auto operator!=(const HugePageAllocator<U> & /*other*/) const noexcept -> bool {
+    return false;
+  }
+};
+
+/// Vector for the large particle and cell arrays.
+template <typename T>
+using LargeVector = std::vector<T, HugePageAllocator<T>>;
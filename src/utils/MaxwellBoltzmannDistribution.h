@@ -20,7 +20,8 @@
 inline std::array<double, 3> maxwellBoltzmannDistributedVelocity(double averageVelocity, size_t dimensions) {
   // we use a constant seed for repeatability.
   // random engine needs static lifetime otherwise it would be recreated for every call.
-  static std::default_random_engine randomEngine(42);
+  // thread_local: the threads of a shared-memory decomposition each generate the same sequence.
+  thread_local std::default_random_engine randomEngine(42);
 
   // when adding independent normally distributed values to all velocity components
   // the velocity change is maxwell boltzmann distributed
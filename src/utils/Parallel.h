@@ -0,0 +1,49 @@
+/**
+ * @file Parallel.h
+ * @brief Thread count helpers shared by the OpenMP-parallel code paths.
+ *
+ * Without OpenMP every helper reports a single thread, so callers never need their own #ifdef.
+ */
+#pragma once
+
+#include <cstdlib>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace parallel {
+
+/// Environment variable that overrides the thread count of the YAML configuration.
+inline constexpr const char *threadCountVariable = "MOLSIM_NUM_THREADS";
+
+/// Number of threads OpenMP would use by default (honours OMP_NUM_THREADS), 1 without OpenMP.
+inline int maxThreads() {
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif
+}
+
+/**
+ * @brief Thread count to run with.
+ *
+ * A positive MOLSIM_NUM_THREADS wins over the configured value, a configured value <= 0 means the OpenMP default.
+ * Without OpenMP the result is always 1.
+ * @param configured Thread count from the configuration file
+ */
+inline int resolveThreadCount(int configured) {
+#ifdef _OPENMP
+  if (const char *env = std::getenv(threadCountVariable)) {
+    const int requested = std::atoi(env);
+    if (requested > 0) return requested;
+  }
+  return configured > 0 ? configured : maxThreads();
+#else
+  (void)configured;
+  return 1;
+#endif
+}
+
+}  // namespace parallel
@@ -0,0 +1,51 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+#include "Affinity.h"
+
+ThreadPool::ThreadPool(std::size_t threads) {
+  threads = std::max<std::size_t>(1, threads);
+  workers.reserve(threads);
+  for (std::size_t i = 0; i < threads; ++i) {
+    workers.emplace_back([this] { work(); });
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    const std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  available.notify_all();
+  for (auto &worker : workers) {
+    worker.join();
+  }
+}
+
+auto ThreadPool::submit(std::function<void()> task) -> std::future<void> {
+  std::packaged_task<void()> packaged(std::move(task));
+  auto result = packaged.get_future();
+  {
+    const std::lock_guard<std::mutex> guard(lock);
+    tasks.push_back(std::move(packaged));
+  }
+  available.notify_one();
+  return result;
+}
+
+void ThreadPool::work() {
+  // the worker inherited the mask of its creator, which may be pinned to the CPU of an OpenMP thread
+  parallel::unpinCurrentThread();
+  while (true) {
+    std::packaged_task<void()> task;
+    {
+      std::unique_lock<std::mutex> guard(lock);
+      available.wait(guard, [this] { return stopping || !tasks.empty(); });
+      if (tasks.empty()) return;  // stopping and drained
+      task = std::move(tasks.front());
+      tasks.pop_front();
+    }
+    task();  // an exception is stored in the future
+  }
+}
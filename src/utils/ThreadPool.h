@@ -0,0 +1,43 @@
+/**
+ * @file ThreadPool.h
+ * @brief Fixed set of worker threads that execute submitted tasks in submission order.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Persistent worker threads, started once and reused for every submitted task.
+ *
+ * Tasks are taken from one FIFO queue. The returned future becomes ready when the task has finished and rethrows
+ * an exception thrown by it. The destructor runs the tasks still queued before joining the workers. The workers run
+ * on all CPUs of the process, also when the creating thread is pinned (parallel::unpinCurrentThread).
+ */
+class ThreadPool {
+ public:
+  /// Start the given number of workers (at least one).
+  explicit ThreadPool(std::size_t threads);
+  ~ThreadPool();
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  /// Queue a task for the next free worker.
+  auto submit(std::function<void()> task) -> std::future<void>;
+  [[nodiscard]] auto size() const noexcept -> std::size_t { return workers.size(); }
+
+ private:
+  void work();
+
+  std::vector<std::thread> workers;
+  std::deque<std::packaged_task<void()>> tasks;
+  std::mutex lock;
+  std::condition_variable available;
+  bool stopping = false;
+};
@@ -0,0 +1,78 @@
+#include "WorkStealingScheduler.h"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+void WorkStealingScheduler::prepare(std::size_t phases, int threads) {
+  threads = std::max(1, threads);
+  if (threads != num_threads || phases != num_phases) {
+    num_threads = threads;
+    num_phases = phases;
+    queues = std::make_unique<Queue[]>(phases * static_cast<std::size_t>(threads));
+  }
+  for (std::size_t i = 0; i < num_phases * static_cast<std::size_t>(num_threads); ++i) {
+    queues[i].tasks.clear();
+    queues[i].head = 0;
+    queues[i].tail = 0;
+  }
+  if (stats.size() != static_cast<std::size_t>(num_threads)) {
+    stats.assign(static_cast<std::size_t>(num_threads), ThreadStats{});
+  }
+}
+
+void WorkStealingScheduler::sortByCost() {
+  std::sort(order.begin(), order.end(), [this](std::size_t a, std::size_t b) { return costs[a] > costs[b]; });
+}
+
+bool WorkStealingScheduler::next(std::size_t phase, int thread, std::size_t &task, bool &stolen) {
+  {
+    auto &own = queue(phase, thread);
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (own.head < own.tail) {
+      task = own.tasks[own.head++];
+      stolen = false;
+      return true;
+    }
+  }
+
+  // steal from the queue with the most remaining tasks, retry if another thief was faster
+  while (true) {
+    int victim = -1;
+    std::size_t most = 0;
+    for (int t = 0; t < num_threads; ++t) {
+      if (t == thread) continue;
+      auto &q = queue(phase, t);
+      std::lock_guard<std::mutex> guard(q.lock);
+      if (q.tail - q.head > most) {
+        most = q.tail - q.head;
+        victim = t;
+      }
+    }
+    if (victim < 0) return false;
+
+    auto &q = queue(phase, victim);
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.head < q.tail) {
+      task = q.tasks[--q.tail];
+      stolen = true;
+      return true;
+    }
+  }
+}
+
+void WorkStealingScheduler::resetStats() { std::fill(stats.begin(), stats.end(), ThreadStats{}); }
+
+void WorkStealingScheduler::logStats() const {
+  if (stats.empty()) return;
+  double total = 0.0;
+  double most = 0.0;
+  for (std::size_t t = 0; t < stats.size(); ++t) {
+    SPDLOG_INFO("Thread {}: busy {:.3f} s, {} cell tasks ({} stolen).", t, stats[t].busySeconds, stats[t].tasks,
+                stats[t].stolen);
+    total += stats[t].busySeconds;
+    most = std::max(most, stats[t].busySeconds);
+  }
+  const double mean = total / static_cast<double>(stats.size());
+  SPDLOG_INFO("Load imbalance (max / mean busy time): {:.3f}.", mean > 0.0 ? most / mean : 1.0);
+}
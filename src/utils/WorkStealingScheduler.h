@@ -0,0 +1,127 @@
+/**
+ * @file WorkStealingScheduler.h
+ * @brief Cost-weighted work-stealing scheduler for the phases of a parallel traversal.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * @brief Distributes weighted tasks over per-thread queues and lets idle threads steal.
+ *
+ * A plan consists of phases (e.g. the colors of the linked-cell traversal) whose tasks may run concurrently, while
+ * the phases themselves run one after another. plan() deals the tasks of every phase out largest cost first, always
+ * to the thread with the least cost so far. During run() every thread works through its own queue from the front;
+ * a thread whose queue is empty steals from the back of the queue with the most remaining tasks. The plan is cheap
+ * to rebuild, so it can follow the particle distribution every step.
+ *
+ * run() is called by all threads of an enclosing parallel region; the caller separates the phases with a barrier.
+ */
+class WorkStealingScheduler {
+ public:
+  /// Accumulated statistics of one thread since the last resetStats().
+  struct ThreadStats {
+    double busySeconds = 0.0;  ///< Time spent inside tasks.
+    std::size_t tasks = 0;     ///< Tasks executed.
+    std::size_t stolen = 0;    ///< Tasks taken from the queue of another thread.
+  };
+
+  /**
+   * @brief Deal out the tasks of every phase to the queues of the given number of threads.
+   * @param phases Task ids of every phase
+   * @param cost Estimated cost of a task id; tasks with a cost <= 0 are dropped
+   * @param threads Number of threads that will call run()
+   */
+  template <typename Cost>
+  void plan(const std::vector<std::vector<std::size_t>> &phases, Cost cost, int threads);
+
+  /**
+   * @brief Execute the tasks of one phase on the calling thread until no queue of the phase has tasks left.
+   * @param phase Index of the phase in the last plan
+   * @param thread Number of the calling thread, 0 <= thread < threads of the plan
+   * @param body Called with every task id
+   */
+  template <typename Body>
+  void run(std::size_t phase, int thread, Body &body);
+
+  [[nodiscard]] auto getThreadStats() const -> const std::vector<ThreadStats> & { return stats; }
+  void resetStats();
+  /// Log the busy time of every thread and the imbalance max / mean.
+  void logStats() const;
+
+ private:
+  struct Queue {
+    std::vector<std::size_t> tasks;
+    std::size_t head = 0;  ///< Next task of the owner.
+    std::size_t tail = 0;  ///< One past the next task of a thief.
+    std::mutex lock;
+  };
+
+  [[nodiscard]] auto queue(std::size_t phase, int thread) -> Queue & {
+    return queues[phase * static_cast<std::size_t>(num_threads) + static_cast<std::size_t>(thread)];
+  }
+  /// Pop from the front of the own queue or steal from the back of the fullest other queue of the phase.
+  bool next(std::size_t phase, int thread, std::size_t &task, bool &stolen);
+  /// Size the queues and the statistics for num_phases x threads.
+  void prepare(std::size_t num_phases, int threads);
+  /// Sort order by descending costs.
+  void sortByCost();
+
+  int num_threads = 0;
+  std::size_t num_phases = 0;
+  std::unique_ptr<Queue[]> queues;
+  std::vector<ThreadStats> stats;
+  std::vector<std::size_t> order;  ///< Scratch for sorting the tasks of a phase by cost.
+  std::vector<double> load;        ///< Scratch for the planned cost per thread.
+  std::vector<double> costs;       ///< Scratch for the costs of the tasks of a phase.
+};
+
+template <typename Cost>
+void WorkStealingScheduler::plan(const std::vector<std::vector<std::size_t>> &phases, Cost cost, int threads) {
+  prepare(phases.size(), threads);
+
+  for (std::size_t phase = 0; phase < phases.size(); ++phase) {
+    const auto &tasks = phases[phase];
+    costs.resize(tasks.size());
+    order.resize(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+      costs[i] = cost(tasks[i]);
+      order[i] = i;
+    }
+    sortByCost();
+
+    load.assign(static_cast<std::size_t>(num_threads), 0.0);
+    for (const auto i : order) {
+      if (costs[i] <= 0.0) break;  // sorted, the remaining tasks have nothing to do
+      std::size_t lightest = 0;
+      for (std::size_t t = 1; t < load.size(); ++t) {
+        if (load[t] < load[lightest]) lightest = t;
+      }
+      load[lightest] += costs[i];
+      queue(phase, static_cast<int>(lightest)).tasks.push_back(tasks[i]);
+    }
+    for (int t = 0; t < num_threads; ++t) {
+      auto &q = queue(phase, t);
+      q.tail = q.tasks.size();
+    }
+  }
+}
+
+template <typename Body>
+void WorkStealingScheduler::run(std::size_t phase, int thread, Body &body) {
+  auto &thread_stats = stats[static_cast<std::size_t>(thread)];
+  std::size_t task = 0;
+  bool stolen = false;
+  while (next(phase, thread, task, stolen)) {
+    const auto start = std::chrono::steady_clock::now();
+    body(task);
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    thread_stats.busySeconds += elapsed.count();
+    ++thread_stats.tasks;
+    if (stolen) ++thread_stats.stolen;
+  }
+}
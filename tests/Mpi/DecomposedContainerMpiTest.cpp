@@ -0,0 +1,105 @@
+/**
+ * @file DecomposedContainerMpiTest.cpp
+ * @brief Runs on several MPI processes (see MolSimMpiTests in CMakeLists.txt) and compares every rank of a
+ * decomposed run with a serial reference computed on the same rank.
+ */
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+
+#include "Container/LinkedCellContainer.h"
+#include "Decomposition/DecomposedContainer.h"
+#include "Decomposition/MpiTransport.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "Simulation/MoleculeSimulation.h"
+#include "utils/ArrayUtils.h"
+
+namespace {
+constexpr double r_cutoff = 2.5;
+constexpr double delta_t = 0.0005;
+
+// a lattice drifting towards the upper corner, so particles cross the sub-box faces along every axis
+void fillDriftingLattice(LinkedCellContainer &container, double side) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> vel(-1.0, 1.0);
+  for (double x = 0.75; x < side; x += 1.5) {
+    for (double y = 0.75; y < side; y += 1.5) {
+      for (double z = 0.75; z < side; z += 1.5) {
+        container.emplaceParticle({x, y, z}, {20.0 + vel(gen), 20.0 + vel(gen), 20.0 + vel(gen)}, 1.0, 0);
+      }
+    }
+  }
+}
+
+// Position, velocity and force of every particle of the decomposed run match the reference particle at the same
+// position, and no particle is lost or duplicated.
+void expectMatchesSerialRun(const std::array<BoundaryCondition, 6> &conditions,
+                            CellTraversal traversal = CellTraversal::HalfShell) {
+  const std::array<double, 3> size{15.0, 15.0, 15.0};
+  auto transport = std::make_unique<MpiTransport>();
+  const auto dims = DomainDecomposition::createDims(transport->size(), {0, 0, 0}, size, r_cutoff);
+  const DomainDecomposition decomposition(transport->rank(), dims, {0.0, 0.0, 0.0}, size);
+
+  LinkedCellContainer reference(r_cutoff, size);
+  DecomposedContainer decomposed(r_cutoff, decomposition, std::move(transport));
+  reference.setBoundaryConditions(conditions);
+  decomposed.setBoundaryConditions(conditions);
+  decomposed.setCellTraversal(traversal);
+  fillDriftingLattice(reference, size[0]);
+  fillDriftingLattice(decomposed, size[0]);
+  const auto initial = decomposed.size();
+
+  TruncatedShiftedLennardJones force(1.0, 1.0, r_cutoff);
+  std::size_t changed = 0;
+  for (int step = 0; step < 100; ++step) {
+    MoleculeSimulation::step(reference, force, delta_t);
+    MoleculeSimulation::step(decomposed, force, delta_t);
+    changed += decomposed.size() != initial ? 1 : 0;
+  }
+
+  EXPECT_EQ(decomposed.globalSize(), reference.size());
+  EXPECT_GT(decomposed.getTransport().allReduceSum(static_cast<double>(changed)), 0.0) << "no particle migrated";
+
+  for (const auto &p : decomposed) {
+    const Particle *match = nullptr;
+    for (const auto &q : reference) {
+      if (ArrayUtils::L2Norm(p.getX() - q.getX()) < 1e-9) match = &q;
+    }
+    ASSERT_NE(match, nullptr) << "no reference particle at " << ArrayUtils::to_string(p.getX());
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_NEAR(p.getV()[d], match->getV()[d], 1e-9);
+      EXPECT_NEAR(p.getF()[d], match->getF()[d], 1e-7 * (1.0 + std::abs(match->getF()[d])));
+    }
+  }
+}
+}  // namespace
+
+TEST(DecomposedContainerMpiTest, OutflowMatchesSerialRun) {
+  std::array<BoundaryCondition, 6> conditions{};
+  conditions.fill(BoundaryCondition::Outflow);
+  expectMatchesSerialRun(conditions);
+}
+
+TEST(DecomposedContainerMpiTest, ReflectingMatchesSerialRun) {
+  std::array<BoundaryCondition, 6> conditions{};
+  conditions.fill(BoundaryCondition::Reflecting);
+  expectMatchesSerialRun(conditions);
+}
+
+// One-sided halo of the eighth shell, forces on the ghosts are returned to their owners.
+TEST(DecomposedContainerMpiTest, EighthShellMatchesSerialRun) {
+  std::array<BoundaryCondition, 6> conditions{};
+  conditions.fill(BoundaryCondition::Reflecting);
+  expectMatchesSerialRun(conditions, CellTraversal::EighthShell);
+}
+
+int main(int argc, char **argv) {
+  const MpiEnvironment mpi(argc, argv);
+  ::testing::InitGoogleTest(&argc, argv);
+  // every rank reports its own result, mpiexec fails if any rank does
+  return RUN_ALL_TESTS();
+}
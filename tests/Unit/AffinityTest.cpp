@@ -0,0 +1,62 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "utils/Affinity.h"
+#include "utils/ThreadPool.h"
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+namespace {
+// Two packages with two cores each and two hardware threads per core, numbered like Linux does:
+// CPUs 0-3 are the first threads of the cores, 4-7 their siblings.
+std::vector<parallel::CpuLocation> dualSocket() {
+  return {{0, 0, 0}, {1, 0, 1}, {2, 1, 0}, {3, 1, 1}, {4, 0, 0}, {5, 0, 1}, {6, 1, 0}, {7, 1, 1}};
+}
+}  // namespace
+
+// Compact fills the cores of the first package before the second one, siblings come last.
+TEST(AffinityTest, CompactFillsOnePackageFirst) {
+  const std::vector<int> expected{0, 1, 2, 3, 4, 5, 6, 7};
+  EXPECT_EQ(parallel::pinningOrder(PinningPolicy::Compact, dualSocket()), expected);
+}
+
+// Scatter alternates between the packages, siblings come last.
+TEST(AffinityTest, ScatterAlternatesPackages) {
+  const std::vector<int> expected{0, 2, 1, 3, 4, 6, 5, 7};
+  EXPECT_EQ(parallel::pinningOrder(PinningPolicy::Scatter, dualSocket()), expected);
+}
+
+TEST(AffinityTest, NoneAndUnknownTopologyPinNothing) {
+  EXPECT_TRUE(parallel::pinningOrder(PinningPolicy::None, dualSocket()).empty());
+  EXPECT_TRUE(parallel::pinningOrder(PinningPolicy::Compact, {}).empty());
+  EXPECT_EQ(parsePinningPolicy("scatter"), PinningPolicy::Scatter);
+  EXPECT_EQ(parsePinningPolicy("Compact"), PinningPolicy::Compact);
+}
+
+#ifdef __linux__
+// A pool started by a pinned thread (the output worker after pinThreads) is not confined to that thread's CPU.
+TEST(AffinityTest, PoolWorkersRunOnAllProcessCpus) {
+  cpu_set_t process;
+  CPU_ZERO(&process);
+  ASSERT_EQ(sched_getaffinity(0, sizeof(process), &process), 0);
+  int first = 0;
+  while (!CPU_ISSET(first, &process)) ++first;
+
+  cpu_set_t pinned, worker;
+  CPU_ZERO(&pinned);
+  CPU_ZERO(&worker);
+  std::thread([&] {
+    ASSERT_TRUE(parallel::pinCurrentThread(first));
+    sched_getaffinity(0, sizeof(pinned), &pinned);
+    ThreadPool pool(1);
+    pool.submit([&] { sched_getaffinity(0, sizeof(worker), &worker); }).get();
+  }).join();
+
+  EXPECT_EQ(CPU_COUNT(&pinned), 1);
+  EXPECT_TRUE(CPU_EQUAL(&worker, &process));
+}
+#endif
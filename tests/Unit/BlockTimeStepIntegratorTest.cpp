@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include "../../src/Container/Particle.h"
+#include "../../src/Container/ParticleContainer.h"
+#include "Integrator/BlockTimeStepIntegrator.h"
+
+namespace {
+// Bodies of input/eingabe-sonne.txt: sun, earth, jupiter, comet.
+void addSolarSystem(ParticleContainer &container) {
+  container.emplaceParticle(std::array<double, 3>{0.0, 0.0, 0.0}, std::array<double, 3>{0.0, 0.0, 0.0}, 1.0);
+  container.emplaceParticle(std::array<double, 3>{0.0, 1.0, 0.0}, std::array<double, 3>{-1.0, 0.0, 0.0}, 3.0e-6);
+  container.emplaceParticle(std::array<double, 3>{0.0, 5.36, 0.0}, std::array<double, 3>{-0.425, 0.0, 0.0}, 9.55e-4);
+  container.emplaceParticle(std::array<double, 3>{34.75, 0.0, 0.0}, std::array<double, 3>{0.0, 0.0296, 0.0}, 1.0e-14);
+}
+}  // namespace
+
+// A light body on a circular orbit (r = 1, v = 1, G*M = 1) must return to its start after one period 2*pi.
+TEST(BlockTimeStepIntegratorTest, CircularOrbitClosesAfterOnePeriod) {
+  ParticleContainer container;
+  container.emplaceParticle(std::array<double, 3>{0.0, 0.0, 0.0}, std::array<double, 3>{0.0, 0.0, 0.0}, 1.0);
+  container.emplaceParticle(std::array<double, 3>{1.0, 0.0, 0.0}, std::array<double, 3>{0.0, 1.0, 0.0}, 1e-10);
+
+  const int steps = 64;
+  BlockTimeStepIntegrator integrator(2.0 * M_PI / steps, 6, 0.01);
+  for (int i = 0; i < steps; ++i) {
+    integrator.step(container);
+  }
+
+  const auto &planet = *(++container.begin());
+  EXPECT_NEAR(planet.getX()[0], 1.0, 1e-3);
+  EXPECT_NEAR(planet.getX()[1], 0.0, 1e-3);
+  EXPECT_NEAR(planet.getV()[1], 1.0, 1e-3);
+}
+
+// Outer bodies must be placed on coarser levels and save force evaluations compared to a global finest step.
+TEST(BlockTimeStepIntegratorTest, HierarchicalSystemUsesFewerForceEvaluations) {
+  ParticleContainer container;
+  addSolarSystem(container);
+
+  BlockTimeStepIntegrator integrator(1.0, 10, 0.02);
+  for (int i = 0; i < 10; ++i) {
+    integrator.step(container);
+  }
+
+  const auto &levels = integrator.getLevels();
+  ASSERT_EQ(levels.size(), 4u);
+  EXPECT_LT(levels[2], levels[1]);  // jupiter coarser than earth
+  EXPECT_LT(levels[3], levels[2]);  // comet coarser than jupiter
+  EXPECT_LT(integrator.getForceEvaluations(), integrator.getGlobalStepEvaluations());
+}
+
+// The earth orbit radius must stay close to 1 over many base steps.
+TEST(BlockTimeStepIntegratorTest, EarthOrbitRadiusIsPreserved) {
+  ParticleContainer container;
+  addSolarSystem(container);
+
+  BlockTimeStepIntegrator integrator(0.5, 10, 0.02);
+  for (int i = 0; i < 100; ++i) {
+    integrator.step(container);
+  }
+
+  auto it = container.begin();
+  const auto sun = it->getX();
+  const auto earth = (++it)->getX();
+  const double r = std::hypot(earth[0] - sun[0], earth[1] - sun[1], earth[2] - sun[2]);
+  EXPECT_NEAR(r, 1.0, 0.05);
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <random>
+#include <vector>
+
+#include "Container/CellLists.h"
+
+// The counting sort groups the particles by cell and keeps the order in which they were added within a cell.
+TEST(CellListsTest, BuildGroupsParticlesByCellInInsertionOrder) {
+  std::vector<Particle> particles(6);
+  const std::array<std::size_t, 6> cell_of{3, 0, 3, 1, 0, 3};
+  CellLists lists;
+  lists.resize(5);
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    lists.add(&particles[i], cell_of[i]);
+  }
+  EXPECT_FALSE(lists.isBuilt());
+  lists.build();
+  ASSERT_TRUE(lists.isBuilt());
+
+  const std::vector<std::vector<Particle *>> expected{
+      {&particles[1], &particles[4]}, {&particles[3]}, {}, {&particles[0], &particles[2], &particles[5]}, {}};
+  for (std::size_t c = 0; c < expected.size(); ++c) {
+    const auto range = lists.cell(c);
+    EXPECT_EQ(std::vector<Particle *>(range.begin(), range.end()), expected[c]) << "cell " << c;
+  }
+  EXPECT_EQ(lists.start(5), particles.size());
+  EXPECT_EQ(lists.sorted().size(), particles.size());
+}
+
+// Particles added after a build join the lists at the next build; clear() empties every cell.
+TEST(CellListsTest, AddAfterBuildAndClear) {
+  std::vector<Particle> particles(3);
+  CellLists lists;
+  lists.resize(2);
+  lists.add(&particles[0], 1);
+  lists.build();
+  lists.add(&particles[1], 0);
+  lists.add(&particles[2], 1);
+  lists.build();
+  EXPECT_EQ(lists.cell(0).size(), 1u);
+  ASSERT_EQ(lists.cell(1).size(), 2u);
+  EXPECT_EQ(lists.cell(1)[0], &particles[0]);
+  EXPECT_EQ(lists.cell(1)[1], &particles[2]);
+
+  lists.clear();
+  EXPECT_EQ(lists.size(), 0u);
+  EXPECT_TRUE(lists.cell(0).empty());
+  EXPECT_TRUE(lists.cell(1).empty());
+}
+
+// The parallel counting sort of assign() gives the same lists as adding the kept particles one by one.
+TEST(CellListsTest, AssignMatchesAddAndBuild) {
+  constexpr std::size_t num_cells = 50;
+  std::vector<Particle> particles(1000);
+  std::vector<std::size_t> cell_of(particles.size());
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<std::size_t> cell(0, num_cells - 1);
+  for (auto &c : cell_of) c = cell(gen);
+  auto keep = [](std::size_t c) { return c % 7 != 0; };
+
+  CellLists serial;
+  serial.resize(num_cells);
+  for (std::size_t i = 0; i < particles.size(); ++i) {
+    if (keep(cell_of[i])) serial.add(&particles[i], cell_of[i]);
+  }
+  serial.build();
+
+  for (const int threads : {1, 4}) {
+    CellLists parallel;
+    parallel.resize(num_cells);
+    parallel.add(&particles[0], 0);  // replaced by assign
+    parallel.assign(particles.size(), [&](std::size_t i) { return &particles[i]; }, cell_of.data(), keep, threads);
+    ASSERT_TRUE(parallel.isBuilt());
+    EXPECT_EQ(parallel.particles(), serial.particles()) << threads << " threads";
+    EXPECT_EQ(parallel.sorted(), serial.sorted()) << threads << " threads";
+    for (std::size_t c = 0; c <= num_cells; ++c) {
+      EXPECT_EQ(parallel.start(c), serial.start(c));
+    }
+  }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+
+#include "Container/LinkedCellContainer.h"
+#include "Decomposition/DecomposedContainer.h"
+#include "Decomposition/DomainDecomposition.h"
+#include "Decomposition/Transport.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "Simulation/MoleculeSimulation.h"
+
+namespace {
+void fillMovingGas(LinkedCellContainer &container, int n, double side) {
+  std::mt19937 gen(11);
+  std::uniform_real_distribution<double> pos(0.0, side);
+  std::uniform_real_distribution<double> vel(-2.0, 2.0);
+  for (int i = 0; i < n; ++i) {
+    container.emplaceParticle({pos(gen), pos(gen), pos(gen)}, {vel(gen), vel(gen), vel(gen)}, 1.0, 0);
+  }
+}
+}  // namespace
+
+TEST(DomainDecompositionTest, CreateDimsPrefersTheSmallestHalo) {
+  // a thin slab is only cut in x and y, a long box along its length
+  EXPECT_EQ(DomainDecomposition::createDims(4, {0, 0, 0}, {12.0, 12.0, 1.0}, 2.5), (std::array<int, 3>{2, 2, 1}));
+  EXPECT_EQ(DomainDecomposition::createDims(4, {0, 0, 0}, {40.0, 10.0, 10.0}, 2.5), (std::array<int, 3>{4, 1, 1}));
+  EXPECT_EQ(DomainDecomposition::createDims(4, {0, 0, 4}, {12.0, 12.0, 12.0}, 2.5), (std::array<int, 3>{1, 1, 4}));
+}
+
+TEST(DomainDecompositionTest, CreateDimsRejectsSubBoxesNarrowerThanTheCutoff) {
+  EXPECT_THROW(DomainDecomposition::createDims(8, {0, 0, 0}, {5.0, 5.0, 1.0}, 2.5), std::invalid_argument);
+  EXPECT_THROW(DomainDecomposition::createDims(4, {3, 0, 0}, {12.0, 12.0, 12.0}, 2.5), std::invalid_argument);
+}
+
+TEST(DomainDecompositionTest, NeighborsAndOwnership) {
+  // rank 3 of a 2x2x1 grid is the upper right sub-box [6, 12) x [6, 12)
+  const DomainDecomposition decomposition(3, {2, 2, 1}, {0.0, 0.0, -0.5}, {12.0, 12.0, 1.0});
+  EXPECT_EQ(decomposition.getCoords(), (std::array<int, 3>{1, 1, 0}));
+  EXPECT_EQ(decomposition.neighbor(Face::XMin), 2);
+  EXPECT_EQ(decomposition.neighbor(Face::YMin), 1);
+  EXPECT_EQ(decomposition.neighbor(Face::XMax), -1);
+  EXPECT_EQ(decomposition.neighbor(Face::ZMin), -1);
+
+  EXPECT_TRUE(decomposition.owns({6.0, 6.0, 0.0}));
+  EXPECT_TRUE(decomposition.owns({13.0, 11.9, 0.0}));  // outside the global box: nearest sub-box
+  EXPECT_FALSE(decomposition.owns({5.99, 7.0, 0.0}));
+  EXPECT_THROW(DomainDecomposition(4, {2, 2, 1}, {0.0, 0.0, 0.0}, {12.0, 12.0, 1.0}), std::invalid_argument);
+}
+
+// With a single rank the decomposed container behaves exactly like the plain linked-cell container.
+TEST(DomainDecompositionTest, SingleRankMatchesLinkedCellContainer) {
+  const std::array<double, 3> size{10.0, 10.0, 10.0};
+  std::array<BoundaryCondition, 6> conditions{};
+  conditions.fill(BoundaryCondition::Reflecting);
+
+  LinkedCellContainer reference(2.5, size);
+  DecomposedContainer decomposed(2.5, DomainDecomposition(0, {1, 1, 1}, {0.0, 0.0, 0.0}, size),
+                                 std::make_unique<SingleRankTransport>());
+  reference.setBoundaryConditions(conditions);
+  decomposed.setBoundaryConditions(conditions);
+  fillMovingGas(reference, 300, 10.0);
+  fillMovingGas(decomposed, 300, 10.0);
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  for (int step = 0; step < 10; ++step) {
+    MoleculeSimulation::step(reference, force, 0.0005);
+    MoleculeSimulation::step(decomposed, force, 0.0005);
+  }
+
+  ASSERT_EQ(decomposed.globalSize(), reference.size());
+  auto p = reference.begin();
+  for (auto q = decomposed.begin(); q != decomposed.end(); ++q, ++p) {
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_DOUBLE_EQ((*p).getX()[d], (*q).getX()[d]);
+      EXPECT_DOUBLE_EQ((*p).getF()[d], (*q).getF()[d]);
+    }
+  }
+}
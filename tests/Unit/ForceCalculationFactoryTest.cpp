@@ -0,0 +1,22 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "ForceCalculation/ForceCalculationFactory.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+
+// Per-type parameters are only understood by the truncated and shifted Lennard-Jones force.
+TEST(ForceCalculationFactoryTest, RejectsParticleTypesForForcesWithoutTypes) {
+  SimulationConfig cfg;
+  cfg.particleTypes.push_back({1, 1.25, 1.4});
+  for (const auto force : {ForceType::LennardJones, ForceType::VectorizedLennardJones, ForceType::Tabulated}) {
+    cfg.forceType = force;
+    EXPECT_THROW(ForceCalculationFactory::createForceCalculation(cfg), std::invalid_argument);
+  }
+
+  cfg.forceType = ForceType::TruncatedShiftedLennardJones;
+  const auto force = ForceCalculationFactory::createForceCalculation(cfg);
+  const auto *ljts = dynamic_cast<const TruncatedShiftedLennardJones *>(force.get());
+  ASSERT_NE(ljts, nullptr);
+  EXPECT_EQ(ljts->getNumTypes(), 2u);
+}
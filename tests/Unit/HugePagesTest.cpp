@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <numeric>
+
+#include "Container/ParticleContainer.h"
+#include "utils/HugePages.h"
+
+namespace {
+// Restores the default mode, the mode is process-wide.
+class HugePagesTest : public ::testing::TestWithParam<HugePageMode> {
+ protected:
+  void TearDown() override { memory::setHugePageMode(HugePageMode::None); }
+};
+}  // namespace
+
+// Large arrays work in every mode (the explicit pool is usually empty and falls back) and are released completely.
+TEST_P(HugePagesTest, LargeArraysRoundTrip) {
+  memory::setHugePageMode(GetParam());
+  const std::size_t n = 3 * memory::hugePageSize / sizeof(double) + 5;
+  {
+    LargeVector<double> values(n);
+    std::iota(values.begin(), values.end(), 0.0);
+    EXPECT_EQ(values[n - 1], static_cast<double>(n - 1));
+
+    const auto stats = memory::hugePageStats();
+    const auto mapped = stats.explicitBytes + stats.transparentBytes;
+    if (GetParam() == HugePageMode::None) {
+      EXPECT_EQ(mapped, 0u);
+    } else {
+      EXPECT_GE(mapped, n * sizeof(double));
+      EXPECT_EQ(reinterpret_cast<std::uintptr_t>(values.data()) % memory::hugePageSize, 0u);
+    }
+
+    // a mode change does not confuse the release of earlier arrays
+    memory::setHugePageMode(HugePageMode::None);
+  }
+  const auto stats = memory::hugePageStats();
+  EXPECT_EQ(stats.explicitBytes + stats.transparentBytes, 0u);
+}
+
+// Small arrays always use the default allocator.
+TEST_P(HugePagesTest, SmallArraysUseTheDefaultAllocator) {
+  memory::setHugePageMode(GetParam());
+  ParticleContainer particles;
+  for (int i = 0; i < 100; ++i) {
+    particles.emplaceParticle({1.0 * i, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0);
+  }
+  EXPECT_EQ(particles.size(), 100u);
+  const auto stats = memory::hugePageStats();
+  EXPECT_EQ(stats.explicitBytes + stats.transparentBytes, 0u);
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, HugePagesTest,
+                         ::testing::Values(HugePageMode::None, HugePageMode::Transparent, HugePageMode::Explicit));
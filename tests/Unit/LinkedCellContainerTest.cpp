@@ -2,12 +2,22 @@
 
 #include <array>
 #include <algorithm>
+#include <cmath>
+#include <random>
 #include <set>
+#include <stdexcept>
+#include <string>
 #include <utility>
 #include <vector>
 
 #include "../../src/Container/LinkedCellContainer.h"
 #include "../../src/Container/Particle.h"
+#include "ForceCalculation/ForceCalculation.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace {
 // Store pairs with deterministic ordering to simplify lookups.
@@ -17,6 +27,57 @@ std::pair<const Particle*, const Particle*> makeOrderedPair(Particle &a, Particl
   }
   return {&a, &b};
 }
+
+// Random gas in a 3D box that is large enough for every color of the parallel traversal.
+void fillRandomGas(LinkedCellContainer &container, int n, double side) {
+  std::mt19937 gen(7);
+  std::uniform_real_distribution<double> dist(0.0, side);
+  for (int i = 0; i < n; ++i) {
+    container.emplaceParticle({dist(gen), dist(gen), dist(gen)}, {0, 0, 0}, 1.0);
+  }
+}
+
+// Both containers hold the same particles in the same order; the forces agree up to the summation order.
+void expectSameForces(LinkedCellContainer &expected, LinkedCellContainer &actual) {
+  ASSERT_EQ(expected.size(), actual.size());
+  auto p = expected.begin();
+  for (auto q = actual.begin(); q != actual.end(); ++q, ++p) {
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_NEAR((*p).getF()[d], (*q).getF()[d], 1e-9 * (1.0 + std::abs((*p).getF()[d])));
+    }
+  }
+}
+
+// Every pair within the cutoff is visited exactly once by both traversals, serially and on 4 threads.
+void expectEveryPairOnce(LinkedCellContainer &container, double r_cutoff) {
+  std::set<std::pair<const Particle*, const Particle*>> expected;
+  for (auto &p : container) {
+    for (auto &q : container) {
+      if (&p == &q) continue;
+      double distance2 = 0.0;
+      for (int d = 0; d < 3; ++d) distance2 += (p.getX()[d] - q.getX()[d]) * (p.getX()[d] - q.getX()[d]);
+      if (distance2 < r_cutoff * r_cutoff) expected.insert(makeOrderedPair(p, q));
+    }
+  }
+  ASSERT_FALSE(expected.empty());
+
+  for (const auto traversal : {CellTraversal::HalfShell, CellTraversal::EighthShell}) {
+    for (const int threads : {1, 4}) {
+      container.setCellTraversal(traversal);
+      container.setNumThreads(threads);
+      std::multiset<std::pair<const Particle*, const Particle*>> visited;
+      container.forEachPair([&](Particle &p, Particle &q) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+        visited.insert(makeOrderedPair(p, q));
+      });
+      for (const auto &pair : expected) {
+        EXPECT_EQ(visited.count(pair), 1u) << "threads " << threads;
+      }
+    }
+  }
+}
 }  // namespace
 
 TEST(LinkedCellContainerTest, ForEachPairVisitsCurrentAndNeighborCellsOnly) {
@@ -273,3 +334,350 @@ TEST(LinkedCellContainerTest, ReflectingBoundaryMirrorsPositionAndVelocity) {
   EXPECT_EQ(ghosts_on_negative_x, 1);
 }
 */
+
+TEST(LinkedCellContainerTest, ResetForcesIsAppliedByTheNextTraversal) {
+  LinkedCellContainer container(1.0, {4.0, 4.0, 1.0});
+  auto &a = container.emplaceParticle({1.1, 1.1, 0.2}, {0, 0, 0}, 1.0);
+  auto &lonely = container.emplaceParticle({3.5, 3.5, 0.2}, {0, 0, 0}, 1.0);
+  a.setF({1.0, 2.0, 3.0});
+  lonely.setF({4.0, 5.0, 6.0});
+
+  // the reset only starts a new force epoch ...
+  container.resetForces();
+  EXPECT_EQ(a.getF(), (std::array<double, 3>{1.0, 2.0, 3.0}));
+
+  // ... every cell is zeroed when a traversal first touches it, even without pairs
+  container.forEachPair([](Particle &, Particle &) {});
+  EXPECT_EQ(a.getF(), (std::array<double, 3>{0.0, 0.0, 0.0}));
+  EXPECT_EQ(lonely.getF(), (std::array<double, 3>{0.0, 0.0, 0.0}));
+
+  // forces added within the same epoch are kept by further traversals
+  a.setF({7.0, 0.0, 0.0});
+  container.forEachPair([](Particle &, Particle &) {});
+  EXPECT_EQ(a.getF(), (std::array<double, 3>{7.0, 0.0, 0.0}));
+}
+
+TEST(LinkedCellContainerTest, ParallelTraversalVisitsEveryPairOnce) {
+  LinkedCellContainer serial(1.0, {7.0, 8.0, 9.0});
+  LinkedCellContainer colored(1.0, {7.0, 8.0, 9.0});
+  fillRandomGas(serial, 400, 7.0);
+  fillRandomGas(colored, 400, 7.0);
+  colored.setNumThreads(4);
+
+  // Every particle counts its partners; under coloring no two threads ever write the same particle.
+  auto countPartners = [](LinkedCellContainer &container) {
+    container.forEachPair([](Particle &p, Particle &q) {
+      p.setF({p.getF()[0] + 1.0, 0.0, 0.0});
+      q.setF({q.getF()[0] + 1.0, 0.0, 0.0});
+    });
+    std::vector<double> counts;
+    for (auto &p : container) {
+      counts.push_back(p.getF()[0]);
+    }
+    return counts;
+  };
+
+  serial.resetForces();
+  colored.resetForces();
+  EXPECT_EQ(countPartners(serial), countPartners(colored));
+}
+
+// The eighth shell visits exactly the cell pairs of the half-stencil, serially and with its 8 colors.
+TEST(LinkedCellContainerTest, EighthShellVisitsTheSamePairsAsHalfShell) {
+  LinkedCellContainer container(1.0, {5.0, 6.0, 7.0});
+  fillRandomGas(container, 300, 5.0);
+
+  auto collectPairs = [&container] {
+    std::vector<std::pair<const Particle *, const Particle *>> pairs;
+    container.forEachPair([&pairs](Particle &p, Particle &q) {
+#ifdef _OPENMP
+#pragma omp critical
+#endif
+      pairs.push_back(makeOrderedPair(p, q));
+    });
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+  };
+
+  const auto half_shell = collectPairs();
+  container.setCellTraversal(CellTraversal::EighthShell);
+  const auto eighth_shell = collectPairs();
+  container.setNumThreads(4);
+  const auto colored = collectPairs();
+
+  EXPECT_EQ(std::adjacent_find(half_shell.begin(), half_shell.end()), half_shell.end());
+  EXPECT_EQ(eighth_shell, half_shell);
+  EXPECT_EQ(colored, half_shell);
+}
+
+TEST(LinkedCellContainerTest, ParallelTraversalMatchesSerialForces) {
+  LinkedCellContainer serial(2.5, {12.0, 12.0, 12.0});
+  LinkedCellContainer colored(2.5, {12.0, 12.0, 12.0});
+  fillRandomGas(serial, 1000, 12.0);
+  fillRandomGas(colored, 1000, 12.0);
+  colored.setNumThreads(3);
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  force.calculateF(serial);
+  force.calculateF(colored);
+
+  expectSameForces(serial, colored);
+}
+
+class LinkedCellParallelStrategyTest : public ::testing::TestWithParam<ParallelStrategy> {};
+
+TEST_P(LinkedCellParallelStrategyTest, MatchesSerialForces) {
+  LinkedCellContainer serial(2.5, {12.0, 12.0, 12.0});
+  LinkedCellContainer parallel(2.5, {12.0, 12.0, 12.0});
+  fillRandomGas(serial, 1000, 12.0);
+  fillRandomGas(parallel, 1000, 12.0);
+  parallel.setNumThreads(3);
+  parallel.setParallelStrategy(GetParam());
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  force.calculateF(serial);
+  // twice, so the lazy reset between two parallel force computations is covered as well
+  force.calculateF(parallel);
+  force.calculateF(parallel);
+
+  expectSameForces(serial, parallel);
+}
+
+TEST_P(LinkedCellParallelStrategyTest, RethrowsExceptionsOfThePairForce) {
+  LinkedCellContainer container(2.5, {12.0, 12.0, 12.0});
+  fillRandomGas(container, 200, 12.0);
+  container.emplaceParticle({6.0, 6.0, 6.0}, {0, 0, 0}, 1.0, 3);  // type without parameters
+  container.setNumThreads(3);
+  container.setParallelStrategy(GetParam());
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  EXPECT_THROW(force.calculateF(container), std::out_of_range);
+}
+
+INSTANTIATE_TEST_SUITE_P(AllStrategies, LinkedCellParallelStrategyTest,
+                         ::testing::Values(ParallelStrategy::Coloring, ParallelStrategy::ThreadBuffers,
+                                           ParallelStrategy::FullShell, ParallelStrategy::Atomic),
+                         [](const ::testing::TestParamInfo<ParallelStrategy> &info) {
+                           return std::string(parallelStrategyName(info.param));
+                         });
+
+#ifdef _OPENMP
+// A team smaller than requested (here nested in an outer region) reduces only its own buffers, not the stale ones of
+// an earlier, larger team.
+TEST(LinkedCellContainerTest, ThreadBuffersReduceOnlyTheRunningTeam) {
+  LinkedCellContainer serial(2.5, {12.0, 12.0, 12.0});
+  LinkedCellContainer parallel(2.5, {12.0, 12.0, 12.0});
+  fillRandomGas(serial, 1000, 12.0);
+  fillRandomGas(parallel, 1000, 12.0);
+  parallel.setNumThreads(4);
+  parallel.setParallelStrategy(ParallelStrategy::ThreadBuffers);
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  force.calculateF(serial);
+  force.calculateF(parallel);
+
+  const int levels = omp_get_max_active_levels();
+  omp_set_max_active_levels(1);
+#pragma omp parallel num_threads(2)
+#pragma omp single
+  force.calculateF(parallel);  // runs on a team of one thread
+  omp_set_max_active_levels(levels);
+
+  expectSameForces(serial, parallel);
+}
+#endif
+
+// A dense drop in an otherwise empty box: the work-stealing schedule must give the serial forces.
+TEST(LinkedCellContainerTest, WorkStealingScheduleMatchesSerialForces) {
+  LinkedCellContainer serial(2.5, {20.0, 20.0, 20.0});
+  LinkedCellContainer stealing(2.5, {20.0, 20.0, 20.0});
+  for (auto *container : {&serial, &stealing}) {
+    fillRandomGas(*container, 100, 20.0);
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<double> drop(8.0, 11.0);
+    for (int i = 0; i < 400; ++i) {
+      container->emplaceParticle({drop(gen), drop(gen), drop(gen)}, {0, 0, 0}, 1.0);
+    }
+  }
+  stealing.setNumThreads(4);
+  stealing.setCellSchedule(CellSchedule::WorkStealing);
+
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  force.calculateF(serial);
+  force.calculateF(stealing);
+  force.calculateF(stealing);
+
+  expectSameForces(serial, stealing);
+
+#ifdef _OPENMP
+  std::size_t tasks = 0;
+  for (const auto &stats : stealing.getScheduler().getThreadStats()) {
+    tasks += stats.tasks;
+  }
+  EXPECT_GT(tasks, 0u);
+#endif
+}
+
+// Integration, outflow removal and ghost creation are per-particle work and give identical results in parallel.
+TEST(LinkedCellContainerTest, ParallelParticleSweepsMatchSerial) {
+  LinkedCellContainer serial(1.0, {6.0, 6.0, 6.0});
+  LinkedCellContainer parallel(1.0, {6.0, 6.0, 6.0});
+  const std::array<BoundaryCondition, 6> conditions{BoundaryCondition::Reflecting, BoundaryCondition::Outflow,
+                                                    BoundaryCondition::Reflecting, BoundaryCondition::Reflecting,
+                                                    BoundaryCondition::Outflow,  BoundaryCondition::Reflecting};
+  for (auto *container : {&serial, &parallel}) {
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<double> position(0.0, 6.0);
+    std::uniform_real_distribution<double> velocity(-20.0, 20.0);
+    for (int i = 0; i < 500; ++i) {
+      container->emplaceParticle({position(gen), position(gen), position(gen)},
+                                 {velocity(gen), velocity(gen), velocity(gen)}, 1.0);
+    }
+    container->setBoundaryConditions(conditions);
+  }
+  parallel.setNumThreads(4);
+
+  for (auto *container : {&serial, &parallel}) {
+    ForceCalculation::calculateX(*container, 0.05);
+    container->rebuild();
+  }
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  EXPECT_LT(serial.size(), 500u);  // some particles left through the outflow faces
+  auto p = serial.begin();
+  for (auto q = parallel.begin(); q != parallel.end(); ++q, ++p) {
+    EXPECT_EQ((*p).getX(), (*q).getX());
+    EXPECT_EQ((*p).getV(), (*q).getV());
+  }
+
+  std::vector<std::array<double, 3>> serial_ghosts, parallel_ghosts;
+  serial.forEachHaloParticle([&](Particle *ghost) { serial_ghosts.push_back(ghost->getX()); });
+  parallel.forEachHaloParticle([&](Particle *ghost) { parallel_ghosts.push_back(ghost->getX()); });
+  EXPECT_FALSE(serial_ghosts.empty());
+  EXPECT_EQ(serial_ghosts, parallel_ghosts);
+}
+
+// Redistributing the storage keeps every particle and its forces, only the order becomes the cell order.
+TEST(LinkedCellContainerTest, DistributeStorageKeepsParticlesInCellOrder) {
+  LinkedCellContainer container(1.0, {6.0, 6.0, 6.0});
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> position(0.0, 6.0);
+  for (int i = 0; i < 400; ++i) {
+    container.emplaceParticle({position(gen), position(gen), position(gen)}, {0.0, 0.0, 0.0}, 1.0);
+  }
+  container.setNumThreads(4);
+  TruncatedShiftedLennardJones force(1.0, 0.5, 1.0);
+  force.calculateF(container);
+
+  std::vector<std::pair<std::array<double, 3>, std::array<double, 3>>> before, after;
+  for (auto &p : container) before.emplace_back(p.getX(), p.getF());
+  container.distributeStorage();
+  for (auto &p : container) after.emplace_back(p.getX(), p.getF());
+  ASSERT_EQ(after.size(), before.size());
+
+  // consecutive particles never go back to a lower cell (z slowest)
+  auto cellOf = [](const std::array<double, 3> &x) {
+    return static_cast<int>(x[0]) + 6 * (static_cast<int>(x[1]) + 6 * static_cast<int>(x[2]));
+  };
+  for (std::size_t i = 1; i < after.size(); ++i) {
+    EXPECT_LE(cellOf(after[i - 1].first), cellOf(after[i].first));
+  }
+  std::sort(before.begin(), before.end());
+  std::sort(after.begin(), after.end());
+  EXPECT_EQ(before, after);
+
+  // the cells point to the new storage
+  force.calculateF(container);
+  std::size_t binned = 0;
+  for (std::size_t c = 0; c < container.numCells(); ++c) binned += container.cellParticles(c).size();
+  EXPECT_EQ(binned, container.size());
+}
+
+// Prefetching changes no pair and no summation order, so the forces are bitwise equal, serial and parallel.
+TEST(LinkedCellContainerTest, PrefetchingKeepsTheForces) {
+  LinkedCellContainer container(1.0, {6.0, 6.0, 6.0});
+  std::mt19937 gen(9);
+  std::uniform_real_distribution<double> position(0.0, 6.0);
+  for (int i = 0; i < 600; ++i) {
+    container.emplaceParticle({position(gen), position(gen), position(gen)}, {0.0, 0.0, 0.0}, 1.0);
+  }
+  TruncatedShiftedLennardJones force(1.0, 0.5, 1.0);
+
+  for (const int threads : {1, 4}) {
+    container.setNumThreads(threads);
+    container.setPrefetchDistance(0);
+    force.calculateF(container);
+    std::vector<std::array<double, 3>> reference;
+    for (auto &p : container) reference.push_back(p.getF());
+
+    for (const int distance : {1, 3, 20}) {
+      container.setPrefetchDistance(distance);
+      force.calculateF(container);
+      std::size_t i = 0;
+      for (auto &p : container) {
+        EXPECT_EQ(p.getF(), reference[i++]) << "threads " << threads << ", distance " << distance;
+      }
+    }
+  }
+}
+
+// A few clusters in a mostly empty grid: every traversal still visits every pair within the cutoff exactly once.
+TEST(LinkedCellContainerTest, SparseGridVisitsEveryPairOnce) {
+  LinkedCellContainer container(1.0, {12.0, 12.0, 12.0});
+  std::mt19937 gen(13);
+  std::uniform_real_distribution<double> offset(0.0, 1.5);
+  for (const auto &center : {std::array<double, 3>{1.0, 1.0, 1.0}, std::array<double, 3>{6.0, 9.0, 3.0},
+                             std::array<double, 3>{10.0, 2.0, 10.0}}) {
+    for (int i = 0; i < 40; ++i) {
+      container.emplaceParticle({center[0] + offset(gen), center[1] + offset(gen), center[2] + offset(gen)},
+                                {0.0, 0.0, 0.0}, 1.0);
+    }
+  }
+  expectEveryPairOnce(container, 1.0);
+}
+
+// The cached cell pairs are reused while the occupied cells stay the same and rebuilt when a particle moves into an
+// empty cell; the pairs stay complete either way.
+TEST(LinkedCellContainerTest, CachedPairsFollowOccupiedCells) {
+  LinkedCellContainer container(1.0, {8.0, 8.0, 8.0});
+  std::mt19937 gen(17);
+  std::uniform_real_distribution<double> offset(0.2, 1.8);
+  for (int i = 0; i < 60; ++i) {
+    container.emplaceParticle({1.0 + offset(gen), 1.0 + offset(gen), 1.0 + offset(gen)}, {0.0, 0.0, 0.0}, 1.0);
+  }
+  auto *traveller = &container.emplaceParticle({2.5, 2.5, 2.5}, {0.0, 0.0, 0.0}, 1.0);
+
+  const auto cached = container.cellPairs();
+  ASSERT_FALSE(cached.empty());
+  const std::size_t generation = container.cellPairsGeneration();
+  container.forEachPair([](Particle &, Particle &) {});
+  EXPECT_EQ(container.cellPairsGeneration(), generation);
+  EXPECT_EQ(container.cellPairs(), cached);
+
+  // halfway to the centre of their cells: the occupied cells and with them the pairs stay
+  container.rebuild([](Particle &p) {
+    std::array<double, 3> x = p.getX();
+    for (auto &coordinate : x) coordinate = 0.5 * (coordinate + std::floor(coordinate) + 0.5);
+    p.setX(x);
+  });
+  EXPECT_EQ(container.cellPairsGeneration(), generation);
+  EXPECT_EQ(container.cellPairs(), cached);
+  expectEveryPairOnce(container, 1.0);
+
+  // into an empty cell far from the others: the pairs are rebuilt and hold the self pair of that cell
+  container.setCellTraversal(CellTraversal::HalfShell);
+  const auto before = container.cellPairs();
+  const std::size_t before_generation = container.cellPairsGeneration();
+  container.rebuild([traveller](Particle &p) {
+    if (&p == traveller) p.setX({6.5, 6.5, 6.5});
+  });
+  EXPECT_GT(container.cellPairsGeneration(), before_generation);
+  const auto refreshed = container.cellPairs();
+  EXPECT_NE(refreshed, before);
+  const auto holds_traveller = [&](const LinkedCellContainer::CellPair &pair) {
+    const auto particles = container.cellParticles(pair[0]);
+    return pair[0] == pair[1] && std::find(particles.begin(), particles.end(), traveller) != particles.end();
+  };
+  EXPECT_EQ(std::count_if(refreshed.begin(), refreshed.end(), holds_traveller), 1);
+  expectEveryPairOnce(container, 1.0);
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "../../src/Container/LinkedCellContainer.h"
+#include "../../src/Container/ParticleContainer.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "Simulation/MoleculeSimulation.h"
+
+namespace {
+// A small, reproducible gas between reflecting walls.
+void fillContainer(LinkedCellContainer &container) {
+  std::mt19937 gen(7);
+  std::normal_distribution<double> vel(0.0, 1.0);
+  for (int x = 0; x < 6; ++x) {
+    for (int y = 0; y < 6; ++y) {
+      for (int z = 0; z < 6; ++z) {
+        container.emplaceParticle({1.0 + 1.3 * x, 1.0 + 1.3 * y, 1.0 + 1.3 * z}, {vel(gen), vel(gen), vel(gen)}, 1.0,
+                                  0);
+      }
+    }
+  }
+  container.setBoundaryConditions({BoundaryCondition::Reflecting, BoundaryCondition::Reflecting,
+                                   BoundaryCondition::Reflecting, BoundaryCondition::Reflecting,
+                                   BoundaryCondition::Reflecting, BoundaryCondition::Reflecting});
+  container.rebuild();
+}
+}  // namespace
+
+// The fused two-sweep step must reproduce the trajectory of the separate sweeps.
+TEST(MoleculeSimulationTest, FusedStepMatchesSeparateSweeps) {
+  const std::array<double, 3> domain{10.0, 10.0, 10.0};
+  const double dt = 0.001;
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+
+  LinkedCellContainer separate(2.5, domain);
+  fillContainer(separate);
+  force.calculateF(separate);
+
+  LinkedCellContainer fused(2.5, domain);
+  fillContainer(fused);
+  force.calculateF(fused);
+
+  for (int i = 1; i <= 50; ++i) {
+    MoleculeSimulation::step(separate, force, dt);
+    MoleculeSimulation::fusedStep(fused, force, dt);
+  }
+
+  ASSERT_EQ(separate.size(), fused.size());
+  auto s = separate.begin();
+  for (auto &p : fused) {
+    EXPECT_EQ(p.getX(), s->getX());
+    EXPECT_EQ(p.getV(), s->getV());
+    EXPECT_EQ(p.getF(), s->getF());
+    ++s;
+  }
+}
+
+// Kick-drift-kick must follow the position/velocity Verlet formulas x += dt v + dt^2 / 2m F(t) and
+// v += dt / 2m (F(t) + F(t + dt)) that were used with a stored old force.
+TEST(MoleculeSimulationTest, KickDriftKickMatchesVelocityVerletFormulas) {
+  const double dt = 0.002;
+  TruncatedShiftedLennardJones force(5.0, 1.0, 3.0);
+  ParticleContainer particles;
+  particles.emplaceParticle({0.0, 0.0, 0.0}, {0.3, -0.1, 0.0}, 1.0, 0);
+  particles.emplaceParticle({1.2, 0.1, 0.0}, {-0.2, 0.0, 0.1}, 2.0, 0);
+  force.calculateF(particles);
+
+  std::vector<Particle> reference(particles.begin(), particles.end());
+  for (int i = 0; i < 100; ++i) {
+    std::vector<std::array<double, 3>> old_f;
+    for (auto &p : reference) {
+      old_f.push_back(p.getF());
+      const auto &x = p.getX();
+      const auto &v = p.getV();
+      const auto &f = p.getF();
+      const double a = dt * dt / (2.0 * p.getM());
+      p.setX({x[0] + dt * v[0] + a * f[0], x[1] + dt * v[1] + a * f[1], x[2] + dt * v[2] + a * f[2]});
+      p.setF({0.0, 0.0, 0.0});
+    }
+    force.calc(reference[0], reference[1]);
+    for (std::size_t k = 0; k < reference.size(); ++k) {
+      auto &p = reference[k];
+      const auto &v = p.getV();
+      const auto &f = p.getF();
+      const double b = dt / (2.0 * p.getM());
+      p.setV({v[0] + b * (old_f[k][0] + f[0]), v[1] + b * (old_f[k][1] + f[1]), v[2] + b * (old_f[k][2] + f[2])});
+    }
+
+    MoleculeSimulation::step(particles, force, dt);
+  }
+
+  auto r = reference.begin();
+  for (auto &p : particles) {
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_NEAR(p.getX()[d], r->getX()[d], 1e-12);
+      EXPECT_NEAR(p.getV()[d], r->getV()[d], 1e-12);
+    }
+    ++r;
+  }
+}
+
+// With several threads the interior pair forces overlap the ghost creation and the outflow; the trajectory must
+// stay that of the serial step up to the summation order.
+TEST(MoleculeSimulationTest, OverlappedStepMatchesSerialStep) {
+  const std::array<double, 3> domain{15.0, 15.0, 15.0};
+  const double dt = 0.001;
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+
+  auto setup = [&](LinkedCellContainer &container, int threads) {
+    std::mt19937 gen(11);
+    std::normal_distribution<double> vel(0.0, 1.0);
+    for (int x = 0; x < 7; ++x) {
+      for (int y = 0; y < 7; ++y) {
+        for (int z = 0; z < 7; ++z) {
+          container.emplaceParticle({1.0 + 2.0 * x, 1.0 + 2.0 * y, 1.0 + 2.0 * z}, {vel(gen), vel(gen), vel(gen)},
+                                    1.0, 0);
+        }
+      }
+    }
+    // a few fast particles leave through the outflow face
+    for (int i = 0; i < 5; ++i) {
+      container.emplaceParticle({14.5, 2.0 + 2.5 * i, 7.0}, {50.0, 0.0, 0.0}, 1.0, 0);
+    }
+    container.setBoundaryConditions({BoundaryCondition::Reflecting, BoundaryCondition::Outflow,
+                                     BoundaryCondition::Reflecting, BoundaryCondition::Reflecting,
+                                     BoundaryCondition::Reflecting, BoundaryCondition::Reflecting});
+    container.setNumThreads(threads);
+    container.rebuild();
+    force.calculateF(container);
+  };
+
+  LinkedCellContainer serial(2.5, domain);
+  setup(serial, 1);
+  LinkedCellContainer overlapped(2.5, domain);
+  setup(overlapped, 4);
+  LinkedCellContainer fused(2.5, domain);
+  setup(fused, 4);
+
+  for (int i = 1; i <= 50; ++i) {
+    MoleculeSimulation::step(serial, force, dt);
+    MoleculeSimulation::step(overlapped, force, dt);
+    MoleculeSimulation::fusedStep(fused, force, dt);
+  }
+
+  ASSERT_EQ(serial.size(), 7u * 7u * 7u);
+  ASSERT_EQ(overlapped.size(), serial.size());
+  ASSERT_EQ(fused.size(), serial.size());
+  auto o = overlapped.begin();
+  auto f = fused.begin();
+  for (auto &p : serial) {
+    for (int d = 0; d < 3; ++d) {
+      EXPECT_NEAR(o->getX()[d], p.getX()[d], 1e-9);
+      EXPECT_NEAR(o->getF()[d], p.getF()[d], 1e-6);
+      EXPECT_NEAR(f->getX()[d], p.getX()[d], 1e-9);
+      EXPECT_NEAR(f->getV()[d], p.getV()[d], 1e-9);
+    }
+    ++o;
+    ++f;
+  }
+}
+
+#ifdef _OPENMP
+// The work-stealing schedule must deal out the cell tasks of every step, not only those of the initial forces.
+TEST(MoleculeSimulationTest, WorkStealingScheduleRunsEveryStep) {
+  LinkedCellContainer container(2.5, {10.0, 10.0, 10.0});
+  fillContainer(container);
+  container.setNumThreads(2);
+  container.setCellSchedule(CellSchedule::WorkStealing);
+  TruncatedShiftedLennardJones force(5.0, 1.0, 2.5);
+  force.calculateF(container);
+
+  auto executed = [&container] {
+    std::size_t tasks = 0;
+    for (const auto &stats : container.getScheduler().getThreadStats()) {
+      tasks += stats.tasks;
+    }
+    return tasks;
+  };
+  std::size_t before = executed();
+  ASSERT_GT(before, 0u);
+  for (int i = 0; i < 5; ++i) {
+    MoleculeSimulation::step(container, force, 0.0005);
+    const std::size_t after = executed();
+    EXPECT_GT(after, before) << "step " << i;
+    before = after;
+  }
+}
+#endif
@@ -0,0 +1,212 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "Container/LinkedCellContainer.h"
+#include "Decomposition/DecomposedContainer.h"
+#include "Decomposition/SharedMemoryTransport.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+#include "Simulation/MoleculeSimulation.h"
+#include "utils/ArrayUtils.h"
+
+namespace {
+constexpr int ranks = 4;
+
+template <typename Body>
+void runOnThreads(Body body, int count = ranks) {
+  std::vector<std::thread> threads;
+  for (int rank = 0; rank < count; ++rank) {
+    threads.emplace_back(body, rank);
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+}
+
+void fillDriftingLattice(LinkedCellContainer &container, double side) {
+  std::mt19937 gen(5);
+  std::uniform_real_distribution<double> vel(-1.0, 1.0);
+  for (double x = 0.75; x < side; x += 1.5) {
+    for (double y = 0.75; y < side; y += 1.5) {
+      for (double z = 0.75; z < side; z += 1.5) {
+        container.emplaceParticle({x, y, z}, {20.0 + vel(gen), 20.0 + vel(gen), 20.0 + vel(gen)}, 1.0, 0);
+      }
+    }
+  }
+}
+
+// Four threads with their own sub-box reproduce a serial run, while particles migrate between them. Returns the
+// number of ghosts imported in the last step.
+std::size_t expectThreadedRunMatchesSerial(CellTraversal traversal) {
+  const std::array<double, 3> size{15.0, 15.0, 15.0};
+  std::array<BoundaryCondition, 6> conditions{};
+  conditions.fill(BoundaryCondition::Reflecting);
+  TruncatedShiftedLennardJones force(1.0, 1.0, 2.5);
+  constexpr int steps = 100;
+
+  LinkedCellContainer reference(2.5, size);
+  reference.setBoundaryConditions(conditions);
+  fillDriftingLattice(reference, size[0]);
+  for (int step = 0; step < steps; ++step) {
+    MoleculeSimulation::step(reference, force, 0.0005);
+  }
+
+  const auto dims = DomainDecomposition::createDims(ranks, {0, 0, 0}, size, 2.5);
+  auto hub = std::make_shared<SharedMemoryHub>(ranks);
+  std::array<std::vector<Particle>, ranks> result;
+  std::array<std::size_t, ranks> initial{};
+  std::array<std::size_t, ranks> imported{};
+  runOnThreads([&](int rank) {
+    DecomposedContainer container(2.5, DomainDecomposition(rank, dims, {0.0, 0.0, 0.0}, size),
+                                  std::make_unique<SharedMemoryTransport>(hub, rank));
+    container.setBoundaryConditions(conditions);
+    container.setCellTraversal(traversal);
+    fillDriftingLattice(container, size[0]);
+    initial[rank] = container.size();
+    for (int step = 0; step < steps; ++step) {
+      MoleculeSimulation::step(container, force, 0.0005);
+    }
+    result[rank].assign(container.begin(), container.end());
+    imported[rank] = container.importedGhosts();
+  });
+
+  std::size_t total = 0;
+  std::size_t total_imported = 0;
+  bool migrated = false;
+  for (int rank = 0; rank < ranks; ++rank) {
+    total += result[rank].size();
+    total_imported += imported[rank];
+    migrated = migrated || result[rank].size() != initial[rank];
+    for (const auto &p : result[rank]) {
+      const Particle *match = nullptr;
+      for (const auto &q : reference) {
+        if (ArrayUtils::L2Norm(p.getX() - q.getX()) < 1e-9) match = &q;
+      }
+      EXPECT_NE(match, nullptr) << "no reference particle at " << ArrayUtils::to_string(p.getX());
+      if (match == nullptr) continue;
+      for (int d = 0; d < 3; ++d) {
+        EXPECT_NEAR(p.getF()[d], match->getF()[d], 1e-7 * (1.0 + std::abs(match->getF()[d])));
+      }
+    }
+  }
+  EXPECT_EQ(total, reference.size());
+  EXPECT_TRUE(migrated);
+  return total_imported;
+}
+}  // namespace
+
+// Every thread sends its rank around a ring and receives the one of its predecessor; the ends have no neighbor.
+TEST(SharedMemoryDecompositionTest, TransportExchangesBuffersAndSums) {
+  auto hub = std::make_shared<SharedMemoryHub>(ranks);
+  std::array<std::vector<double>, ranks> received;
+  std::array<double, ranks> sums{};
+
+  runOnThreads([&](int rank) {
+    SharedMemoryTransport transport(hub, rank);
+    const int next = rank + 1 < ranks ? rank + 1 : -1;
+    const int previous = rank - 1;
+    for (int round = 0; round < 3; ++round) {
+      transport.sendRecv(std::vector<double>(static_cast<std::size_t>(rank + 1), rank), next, received[rank],
+                         previous);
+    }
+    sums[rank] = transport.allReduceSum(rank);
+  });
+
+  EXPECT_TRUE(received[0].empty());
+  for (int rank = 1; rank < ranks; ++rank) {
+    EXPECT_EQ(received[rank], std::vector<double>(static_cast<std::size_t>(rank), rank - 1));
+  }
+  for (const double sum : sums) {
+    EXPECT_EQ(sum, 6.0);
+  }
+}
+
+// A thread that fails aborts the hub: the others leave their exchanges with Aborted instead of waiting forever.
+TEST(SharedMemoryDecompositionTest, FailingThreadReleasesTheOthers) {
+  auto hub = std::make_shared<SharedMemoryHub>(ranks);
+  std::array<bool, ranks> released{};
+
+  runOnThreads([&](int rank) {
+    SharedMemoryTransport transport(hub, rank);
+    std::vector<double> received;
+    try {
+      transport.sendRecv({1.0}, -1, received, -1);
+      if (rank == 2) throw std::runtime_error("rank-local error");
+      for (int round = 0; round < 3; ++round) {
+        transport.sendRecv({1.0}, -1, received, -1);
+      }
+    } catch (const SharedMemoryHub::Aborted &) {
+      released[rank] = true;
+    } catch (const std::runtime_error &) {
+      hub->abort();
+    }
+  });
+
+  for (int rank = 0; rank < ranks; ++rank) {
+    EXPECT_EQ(released[rank], rank != 2) << "rank " << rank;
+  }
+}
+
+TEST(SharedMemoryDecompositionTest, ThreadedSubBoxesMatchSerialRun) {
+  expectThreadedRunMatchesSerial(CellTraversal::HalfShell);
+}
+
+// Every pair is computed once and the ghost forces are sent back; only the halos of the upper faces are imported.
+TEST(SharedMemoryDecompositionTest, EighthShellSubBoxesMatchSerialRunWithASmallerHalo) {
+  const auto half_shell = expectThreadedRunMatchesSerial(CellTraversal::HalfShell);
+  const auto eighth_shell = expectThreadedRunMatchesSerial(CellTraversal::EighthShell);
+  EXPECT_LT(eighth_shell, half_shell);
+}
+
+// The forces at t_start already include the partners across the face between two sub-boxes.
+TEST(SharedMemoryDecompositionTest, InitialForcesMatchSerialForces) {
+  const std::array<double, 3> size{10.0, 5.0, 5.0};
+  const std::array<int, 3> dims{2, 1, 1};
+  TruncatedShiftedLennardJones force(1.0, 1.0, 2.5);
+
+  LinkedCellContainer reference(2.5, size);
+  std::mt19937 gen(3);
+  std::uniform_real_distribution<double> jitter(-0.1, 0.1);
+  for (double x = 0.5; x < size[0]; x += 1.0) {
+    for (double y = 0.5; y < size[1]; y += 1.0) {
+      for (double z = 0.5; z < size[2]; z += 1.0) {
+        reference.emplaceParticle({x + jitter(gen), y + jitter(gen), z + jitter(gen)}, {0.0, 0.0, 0.0}, 1.0, 0);
+      }
+    }
+  }
+  MoleculeSimulation::initialForces(reference, force);
+
+  auto hub = std::make_shared<SharedMemoryHub>(2);
+  std::array<std::vector<Particle>, 2> result;
+  runOnThreads(
+      [&](int rank) {
+        DecomposedContainer container(2.5, DomainDecomposition(rank, dims, {0.0, 0.0, 0.0}, size),
+                                      std::make_unique<SharedMemoryTransport>(hub, rank));
+        for (const auto &p : reference) {
+          container.emplaceParticle(p.getX(), p.getV(), p.getM(), p.getType());
+        }
+        MoleculeSimulation::initialForces(container, force);
+        result[rank].assign(container.begin(), container.end());
+      },
+      2);
+
+  ASSERT_EQ(result[0].size() + result[1].size(), reference.size());
+  for (const auto &particles : result) {
+    for (const auto &p : particles) {
+      const Particle *match = nullptr;
+      for (const auto &q : reference) {
+        if (ArrayUtils::L2Norm(p.getX() - q.getX()) < 1e-12) match = &q;
+      }
+      ASSERT_NE(match, nullptr) << "no reference particle at " << ArrayUtils::to_string(p.getX());
+      for (int d = 0; d < 3; ++d) {
+        EXPECT_NEAR(p.getF()[d], match->getF()[d], 1e-9 * (1.0 + std::abs(match->getF()[d])));
+      }
+    }
+  }
+}
@@ -0,0 +1,101 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Simulation/StepExecutor.h"
+#include "utils/ThreadPool.h"
+
+// Every phase runs once per step and only after all of its dependencies.
+TEST(StepExecutorTest, RunsPhasesInDependencyOrder) {
+  ThreadPool pool(2);
+  StepExecutor executor(pool);
+  std::mutex lock;
+  std::vector<std::string> order;
+  auto record = [&](const std::string &name) {
+    return [&, name](int) {
+      const std::lock_guard<std::mutex> guard(lock);
+      order.push_back(name);
+    };
+  };
+
+  const auto x = executor.addPhase("x", record("x"));
+  const auto a = executor.addPhase("a", record("a"), {x});
+  const auto b = executor.addPhase("b", record("b"), {x});
+  executor.addPhase("v", record("v"), {a, b});
+
+  for (int step = 1; step <= 20; ++step) {
+    order.clear();
+    executor.run(step);
+    ASSERT_EQ(order.size(), 4u);
+    EXPECT_EQ(order.front(), "x");
+    EXPECT_EQ(order.back(), "v");
+  }
+}
+
+// Independent phases that are ready together run concurrently: each one waits until the other has started.
+TEST(StepExecutorTest, RunsIndependentPhasesConcurrently) {
+  ThreadPool pool(1);
+  StepExecutor executor(pool);
+  std::promise<void> a_started, b_started;
+  auto a_seen = b_started.get_future();
+  auto b_seen = a_started.get_future();
+  executor.addPhase("a", [&](int) {
+    a_started.set_value();
+    ASSERT_EQ(a_seen.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  });
+  executor.addPhase("b", [&](int) {
+    b_started.set_value();
+    ASSERT_EQ(b_seen.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+  });
+  executor.run(1);
+}
+
+// A phase overlapping the next step may still run after run() returned, but its instances never overlap each other.
+TEST(StepExecutorTest, OverlappingPhaseRunsBehindTheStep) {
+  ThreadPool pool(1);
+  StepExecutor executor(pool);
+  std::atomic<int> running{0};
+  std::atomic<int> written{0};
+  std::atomic<bool> overlapped{false};
+  const auto compute = executor.addPhase("compute", [](int) {});
+  executor.addPhase(
+      "output",
+      [&](int) {
+        if (running.fetch_add(1) != 0) overlapped = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        ++written;
+        --running;
+      },
+      {compute}, true);
+
+  for (int step = 1; step <= 10; ++step) {
+    executor.run(step);
+  }
+  executor.wait();
+  EXPECT_EQ(written, 10);
+  EXPECT_FALSE(overlapped);
+  EXPECT_THROW(executor.addPhase("late", [](int) {}, {1}), std::invalid_argument);
+}
+
+// The exception of a phase reaches the caller and the phases after it are skipped.
+TEST(StepExecutorTest, RethrowsAndSkipsDependentPhases) {
+  ThreadPool pool(2);
+  StepExecutor executor(pool);
+  int after = 0;
+  const auto failing = executor.addPhase("failing", [](int step) {
+    if (step == 2) throw std::runtime_error("phase failed");
+  });
+  executor.addPhase("after", [&](int) { ++after; }, {failing});
+
+  executor.run(1);
+  EXPECT_THROW(executor.run(2), std::runtime_error);
+  executor.run(3);
+  EXPECT_EQ(after, 2);
+}
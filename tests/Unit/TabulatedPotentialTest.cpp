@@ -0,0 +1,96 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "../../src/Container/Particle.h"
+#include "ForceCalculation/TabulatedPotential.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+
+namespace {
+Particle particleAt(double x) {
+  Particle p;
+  p.setX({x, 0.0, 0.0});
+  p.setF({0.0, 0.0, 0.0});
+  return p;
+}
+}  // namespace
+
+// The tabulated Lennard-Jones potential reproduces the analytic truncated and shifted one.
+TEST(TabulatedPotentialTest, LennardJonesMatchesAnalyticForceAndEnergy) {
+  const auto table = TabulatedPotential::lennardJones(5.0, 1.0, 0.8, 2.5, 4096);
+  const TruncatedShiftedLennardJones analytic(5.0, 1.0, 2.5);
+
+  for (double r = 0.85; r < 2.5; r += 0.0137) {
+    Particle a = particleAt(0.0), b = particleAt(r);
+    Particle c = particleAt(0.0), d = particleAt(r);
+    table.calc(a, b);
+    analytic.calc(c, d);
+    EXPECT_NEAR(a.getF()[0], c.getF()[0], 1e-6 * (1.0 + std::abs(c.getF()[0]))) << "r = " << r;
+    EXPECT_NEAR(table.calculateU(a, b), analytic.calculateU(c, d), 1e-7) << "r = " << r;
+  }
+
+  Particle a = particleAt(0.0), b = particleAt(2.5);
+  table.calc(a, b);
+  EXPECT_EQ(a.getF()[0], 0.0);
+}
+
+// Morse forces follow the analytic derivative; the energy is zero at the cutoff.
+TEST(TabulatedPotentialTest, MorseMatchesAnalyticDerivative) {
+  const double depth = 2.0, width = 1.5, r0 = 1.2, rc = 4.0;
+  const auto table = TabulatedPotential::morse(depth, width, r0, 0.5, rc, 4096);
+
+  for (const double r : {0.7, 1.0, 1.2, 1.9, 3.5}) {
+    double u, f_over_r;
+    table.evaluate(r * r, u, f_over_r);
+    const double e = std::exp(-width * (r - r0));
+    const double du_dr = 2.0 * depth * width * e * (1.0 - e);
+    EXPECT_NEAR(f_over_r * r, -du_dr, 1e-6 * (1.0 + std::abs(du_dr))) << "r = " << r;
+  }
+  double u, f_over_r;
+  table.evaluate(rc * rc * (1.0 - 1e-12), u, f_over_r);
+  EXPECT_NEAR(u, 0.0, 1e-9);
+}
+
+// A non-uniform user table is resampled onto the r^2 grid.
+TEST(TabulatedPotentialTest, FileTableMatchesGeneratedTable) {
+  const std::string path = "tabulated_potential_test.txt";
+  {
+    std::ofstream out(path);
+    out.precision(12);
+    out << "# r U F\n";
+    for (double r = 0.8; r < 2.61; r += 0.002 + 0.002 * (r - 0.8)) {
+      const double sr6 = std::pow(1.0 / r, 6);
+      out << r << ' ' << 4.0 * (sr6 * sr6 - sr6) << ' ' << 24.0 * sr6 * (2.0 * sr6 - 1.0) / r << '\n';
+    }
+  }
+  const auto from_file = TabulatedPotential::fromFile(path, 2.5, 4096);
+  const auto generated = TabulatedPotential::lennardJones(1.0, 1.0, 0.8, 2.5, 4096);
+  std::remove(path.c_str());
+
+  for (double r = 0.85; r < 2.5; r += 0.05) {
+    double u1, f1, u2, f2;
+    from_file.evaluate(r * r, u1, f1);
+    generated.evaluate(r * r, u2, f2);
+    EXPECT_NEAR(f1, f2, 1e-4 * (1.0 + std::abs(f2))) << "r = " << r;
+    EXPECT_NEAR(u1, u2, 1e-5 * (1.0 + std::abs(u2))) << "r = " << r;
+  }
+
+  EXPECT_THROW(TabulatedPotential::fromFile("does_not_exist.txt", 2.5, 16), std::runtime_error);
+}
+
+// A table whose r does not strictly increase is rejected, e.g. a duplicated row.
+TEST(TabulatedPotentialTest, FileTableRejectsRepeatedR) {
+  const std::string path = "tabulated_potential_repeated_r.txt";
+  {
+    std::ofstream out(path);
+    out << "1.0 1.0 2.0\n"
+        << "1.5 0.5 1.0\n"
+        << "1.5 0.5 1.0\n"
+        << "3.0 0.0 0.0\n";
+  }
+  EXPECT_THROW(TabulatedPotential::fromFile(path, 2.5, 16), std::runtime_error);
+  std::remove(path.c_str());
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "../../src/Container/Particle.h"
+#include "../../src/Container/ParticleContainer.h"
+#include "ForceCalculation/LennardJones.h"
+#include "ForceCalculation/TruncatedShiftedLennardJones.h"
+
+namespace {
+Particle particleAt(double x, int type = 0) {
+  Particle p(type);
+  p.setX({x, 0.0, 0.0});
+  p.setF({0.0, 0.0, 0.0});
+  return p;
+}
+}  // namespace
+
+// Inside the cutoff the force equals the plain Lennard-Jones force.
+TEST(TruncatedShiftedLennardJonesTest, MatchesLennardJonesInsideCutoff) {
+  const TruncatedShiftedLennardJones ljts(5.0, 1.0, 3.0);
+  for (const double r : {0.9, 1.12, 1.5, 2.9}) {
+    Particle a = particleAt(0.0), b = particleAt(r);
+    Particle c = particleAt(0.0), d = particleAt(r);
+    ljts.calc(a, b);
+    LennardJones::calc(c, d, 5.0, 1.0);
+    EXPECT_NEAR(a.getF()[0], c.getF()[0], 1e-12 * std::abs(c.getF()[0]));
+    EXPECT_NEAR(b.getF()[0], d.getF()[0], 1e-12 * std::abs(d.getF()[0]));
+  }
+}
+
+// Energy and force vanish at the cutoff; coincident particles do not produce NaNs.
+TEST(TruncatedShiftedLennardJonesTest, VanishesAtCutoff) {
+  const TruncatedShiftedLennardJones ljts(5.0, 1.0, 2.5);
+  Particle a = particleAt(0.0), b = particleAt(2.5);
+  ljts.calc(a, b);
+  EXPECT_EQ(a.getF()[0], 0.0);
+  EXPECT_EQ(ljts.calculateU(a, b), 0.0);
+  EXPECT_NEAR(ljts.calculateU(particleAt(0.0), particleAt(2.5 - 1e-9)), 0.0, 1e-9);
+
+  Particle p = particleAt(1.0), q = particleAt(1.0);
+  ljts.calc(p, q);
+  EXPECT_EQ(p.getF()[0], 0.0);
+}
+
+// The force is the negative derivative of the shifted energy.
+TEST(TruncatedShiftedLennardJonesTest, ForceIsEnergyGradient) {
+  const TruncatedShiftedLennardJones ljts(5.0, 1.0, 2.5);
+  const double h = 1e-6;
+  for (const double r : {0.95, 1.2, 2.0, 2.4}) {
+    Particle a = particleAt(0.0), b = particleAt(r);
+    ljts.calc(a, b);
+    const double dU = (ljts.calculateU(particleAt(0.0), particleAt(r + h)) -
+                       ljts.calculateU(particleAt(0.0), particleAt(r - h))) /
+                      (2.0 * h);
+    EXPECT_NEAR(b.getF()[0], -dU, 1e-5 * (1.0 + std::abs(dU)));
+  }
+}
+
+// Mixed pairs use the Lorentz-Berthelot parameters, equal types their own parameters.
+TEST(TruncatedShiftedLennardJonesTest, MixesTypeParametersWithLorentzBerthelot) {
+  const TruncatedShiftedLennardJones multi({{5.0, 1.0}, {1.25, 1.4}}, 3.0);
+  ASSERT_EQ(multi.getNumTypes(), 2u);
+
+  const TruncatedShiftedLennardJones mixed(std::sqrt(5.0 * 1.25), 1.2, 3.0);
+  const TruncatedShiftedLennardJones second(1.25, 1.4, 3.0);
+  for (const double r : {1.0, 1.3, 2.2}) {
+    Particle a = particleAt(0.0, 0), b = particleAt(r, 1);
+    Particle c = particleAt(0.0), d = particleAt(r);
+    multi.calc(a, b);
+    mixed.calc(c, d);
+    EXPECT_NEAR(a.getF()[0], c.getF()[0], 1e-12 * std::abs(c.getF()[0]));
+    EXPECT_NEAR(multi.calculateU(a, b), mixed.calculateU(c, d), 1e-12);
+
+    Particle e = particleAt(0.0, 1), f = particleAt(r, 1);
+    Particle g = particleAt(0.0), h = particleAt(r);
+    multi.calc(e, f);
+    second.calc(g, h);
+    EXPECT_NEAR(e.getF()[0], g.getF()[0], 1e-12 * std::abs(g.getF()[0]));
+  }
+}
+
+// Particles whose type has no parameters are rejected before the force loop.
+TEST(TruncatedShiftedLennardJonesTest, RejectsUnknownTypes) {
+  TruncatedShiftedLennardJones ljts(5.0, 1.0, 3.0);
+  ParticleContainer container;
+  container.emplaceParticle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 0);
+  container.emplaceParticle({1.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0, 3);
+  EXPECT_THROW(ljts.calculateF(container), std::out_of_range);
+}
@@ -0,0 +1,84 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "../../src/Container/LinkedCellContainer.h"
+#include "../../src/Container/ParticleContainer.h"
+#include "ForceCalculation/LennardJones.h"
+#include "ForceCalculation/VectorizedLennardJones.h"
+
+namespace {
+// Fills the container with a reproducible random gas of n particles.
+void addRandomGas(Container &container, const std::array<double, 3> &domain, int n) {
+  std::mt19937 gen(42);
+  std::uniform_real_distribution<double> dist(0.0, 1.0);
+  for (int i = 0; i < n; ++i) {
+    container.emplaceParticle({domain[0] * dist(gen), domain[1] * dist(gen), domain[2] * dist(gen)}, {0.0, 0.0, 0.0},
+                              1.0, 0);
+  }
+}
+
+std::vector<std::array<double, 3>> forces(Container &container) {
+  std::vector<std::array<double, 3>> result;
+  for (auto &p : container) {
+    result.push_back(p.getF());
+  }
+  return result;
+}
+}  // namespace
+
+// Every kernel the CPU supports must reproduce the scalar Lennard-Jones forces of the linked-cell traversal.
+TEST(VectorizedLennardJonesTest, MatchesLennardJonesForEverySupportedIsa) {
+  const std::array<double, 3> domain{9.0, 9.0, 9.0};
+
+  LinkedCellContainer reference(3.0, domain);
+  addRandomGas(reference, domain, 300);
+  LennardJones lj;
+  lj.setEpsilon(5.0);
+  lj.setSigma(1.0);
+  lj.calculateF(reference);
+  const auto expected = forces(reference);
+
+  for (const auto isa : {LennardJonesKernel::Isa::Scalar, LennardJonesKernel::Isa::SSE4, LennardJonesKernel::Isa::AVX2,
+                         LennardJonesKernel::Isa::AVX512}) {
+    if (!LennardJonesKernel::isSupported(isa)) continue;
+
+    LinkedCellContainer container(3.0, domain);
+    addRandomGas(container, domain, 300);
+    VectorizedLennardJones vectorized(5.0, 1.0, 0.0, isa);
+    vectorized.calculateF(container);
+    const auto actual = forces(container);
+
+    ASSERT_EQ(actual.size(), expected.size());
+    for (std::size_t i = 0; i < actual.size(); ++i) {
+      for (int d = 0; d < 3; ++d) {
+        EXPECT_NEAR(actual[i][d], expected[i][d], 1e-9 * (1.0 + std::abs(expected[i][d])))
+            << LennardJonesKernel::isaName(isa) << " particle " << i;
+      }
+    }
+  }
+}
+
+// Pairs at or beyond the cutoff radius must not contribute.
+TEST(VectorizedLennardJonesTest, CutoffMasksDistantPairs) {
+  ParticleContainer container;
+  container.emplaceParticle({0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0);
+  container.emplaceParticle({1.5, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0);
+  container.emplaceParticle({5.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, 1.0);
+
+  VectorizedLennardJones vectorized(5.0, 1.0, 3.0);
+  vectorized.calculateF(container);
+
+  Particle p1, p2;
+  p1.setX({0.0, 0.0, 0.0});
+  p2.setX({1.5, 0.0, 0.0});
+  LennardJones::calc(p1, p2, 5.0, 1.0);
+
+  const auto f = forces(container);
+  EXPECT_NEAR(f[0][0], p1.getF()[0], 1e-12);
+  EXPECT_NEAR(f[1][0], p2.getF()[0], 1e-12);
+  EXPECT_DOUBLE_EQ(f[2][0], 0.0);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+
+#include "../../src/Container/Particle.h"
+#include "../../src/Container/ParticleContainer.h"
+#include "ForceCalculation/StormerVerlet.h"
+#include "Integrator/WisdomHolmanIntegrator.h"
+
+namespace {
+// Total energy (kinetic + gravitational, G = 1) of all particles.
+double totalEnergy(ParticleContainer &container) {
+  double kinetic = 0.0;
+  double potential = 0.0;
+  for (auto &p : container) {
+    const auto &v = p.getV();
+    kinetic += 0.5 * p.getM() * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+  }
+  container.forEachPair([&](Particle &p, Particle &q) {
+    const auto &a = p.getX();
+    const auto &b = q.getX();
+    potential -= p.getM() * q.getM() / std::hypot(a[0] - b[0], a[1] - b[1], a[2] - b[2]);
+  });
+  return kinetic + potential;
+}
+
+void addSunJupiterEarth(ParticleContainer &container) {
+  container.emplaceParticle(std::array<double, 3>{0.0, 0.0, 0.0}, std::array<double, 3>{0.0, 0.0, 0.0}, 1.0);
+  container.emplaceParticle(std::array<double, 3>{0.0, 1.0, 0.0}, std::array<double, 3>{-1.0, 0.0, 0.0}, 3.0e-6);
+  container.emplaceParticle(std::array<double, 3>{0.0, 5.36, 0.0}, std::array<double, 3>{-0.425, 0.0, 0.0}, 9.55e-4);
+}
+}  // namespace
+
+// The analytic Kepler drift must close an eccentric orbit (e = 0.5, a = 1, mu = 1) after one period.
+TEST(WisdomHolmanIntegratorTest, KeplerDriftIsExactForEllipticOrbit) {
+  // perihelion r = a (1 - e) = 0.5 with speed sqrt(mu (1 + e) / (a (1 - e))) = sqrt(3)
+  std::array<double, 3> x{0.5, 0.0, 0.0};
+  std::array<double, 3> v{0.0, std::sqrt(3.0), 0.0};
+
+  for (int i = 0; i < 7; ++i) {
+    WisdomHolmanIntegrator::keplerDrift(x, v, 1.0, 2.0 * M_PI / 7.0);
+  }
+
+  EXPECT_NEAR(x[0], 0.5, 1e-10);
+  EXPECT_NEAR(x[1], 0.0, 1e-10);
+  EXPECT_NEAR(v[1], std::sqrt(3.0), 1e-10);
+}
+
+// Hyperbolic orbits must be handled as well: the drift has to conserve the orbital energy.
+TEST(WisdomHolmanIntegratorTest, KeplerDriftConservesEnergyOnHyperbolicOrbit) {
+  std::array<double, 3> x{1.0, 0.0, 0.0};
+  std::array<double, 3> v{0.0, 2.0, 0.0};
+  const double energy = 0.5 * 4.0 - 1.0;
+
+  WisdomHolmanIntegrator::keplerDrift(x, v, 1.0, 10.0);
+
+  const double r = std::hypot(x[0], x[1], x[2]);
+  EXPECT_NEAR(0.5 * (v[0] * v[0] + v[1] * v[1] + v[2] * v[2]) - 1.0 / r, energy, 1e-10);
+  EXPECT_GT(r, 10.0);
+}
+
+// With a ten times larger step, Wisdom-Holman must still have a smaller energy error than Störmer-Verlet.
+TEST(WisdomHolmanIntegratorTest, LargerStepsBeatStormerVerletEnergyError) {
+  const double t_end = 50.0;
+
+  ParticleContainer wh_particles;
+  addSunJupiterEarth(wh_particles);
+  const double e0 = totalEnergy(wh_particles);
+  const double wh_dt = 0.1;
+  WisdomHolmanIntegrator wh(wh_dt);
+  for (int i = 0; i < static_cast<int>(t_end / wh_dt); ++i) {
+    wh.step(wh_particles);
+  }
+  const double wh_error = std::abs((totalEnergy(wh_particles) - e0) / e0);
+
+  ParticleContainer sv_particles;
+  addSunJupiterEarth(sv_particles);
+  const double sv_dt = 0.01;
+  StormerVerlet verlet;
+  verlet.calculateF(sv_particles);
+  for (int i = 0; i < static_cast<int>(t_end / sv_dt); ++i) {
+    StormerVerlet::calculateX(sv_particles, sv_dt);
+    verlet.calculateF(sv_particles);
+    StormerVerlet::calculateV(sv_particles, sv_dt);
+  }
+  const double sv_error = std::abs((totalEnergy(sv_particles) - e0) / e0);
+
+  EXPECT_LT(wh_error, sv_error);
+}
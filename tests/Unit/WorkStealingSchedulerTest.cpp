@@ -0,0 +1,50 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "utils/WorkStealingScheduler.h"
+
+namespace {
+double costOf(std::size_t task) { return static_cast<double>(task % 5); }
+}  // namespace
+
+// Every task with a positive cost runs exactly once, tasks without cost are dropped.
+TEST(WorkStealingSchedulerTest, RunsEveryTaskOnce) {
+  WorkStealingScheduler scheduler;
+  const std::vector<std::vector<std::size_t>> phases{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, {10, 11, 12}};
+  scheduler.plan(phases, costOf, 3);
+
+  std::vector<int> runs(13, 0);
+  auto body = [&runs](std::size_t task) { ++runs[task]; };
+  for (std::size_t phase = 0; phase < phases.size(); ++phase) {
+    for (int thread = 0; thread < 3; ++thread) {
+      scheduler.run(phase, thread, body);
+    }
+  }
+
+  for (std::size_t task = 0; task < runs.size(); ++task) {
+    EXPECT_EQ(runs[task], costOf(task) > 0.0 ? 1 : 0) << "task " << task;
+  }
+}
+
+// A thread that runs alone finishes the queues of the others by stealing.
+TEST(WorkStealingSchedulerTest, IdleThreadStealsRemainingTasks) {
+  WorkStealingScheduler scheduler;
+  scheduler.plan({{1, 2, 3, 4, 6, 7, 8, 9}}, costOf, 2);
+
+  std::size_t executed = 0;
+  auto body = [&executed](std::size_t) { ++executed; };
+  scheduler.run(0, 1, body);
+
+  const auto &stats = scheduler.getThreadStats();
+  EXPECT_EQ(executed, 8u);
+  EXPECT_EQ(stats[1].tasks, 8u);
+  // the costs 4, 4, 3, 3, 2, 2, 1, 1 are dealt out alternately, half of them to thread 0
+  EXPECT_EQ(stats[1].stolen, 4u);
+  EXPECT_EQ(stats[0].tasks, 0u);
+
+  scheduler.resetStats();
+  EXPECT_EQ(scheduler.getThreadStats()[1].tasks, 0u);
+}
+